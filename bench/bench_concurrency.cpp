@@ -0,0 +1,63 @@
+//пропускная способность константных запросов к одному общему объекту OrthodoxCalendar
+//в зависимости от кол-ва потоков (1..N). общий объем работы делится между потоками поровну;
+//второй столбец - с малым лимитом кэша, при котором потоки постоянно строят и вытесняют годы.
+//параметры: [N (по умолчанию std::thread::hardware_concurrency())] [кол-во запросов (по умолчанию 400000)]
+#include "oxc.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace oxc;
+
+namespace {
+
+//запросов в секунду при выполнении queries запросов в threads потоках
+double throughput(const OrthodoxCalendar& c, const unsigned threads, const unsigned long queries)
+{
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for(unsigned t = 0; t < threads; ++t) {
+    pool.emplace_back([&c, t, threads, queries]{
+      unsigned long sink{};
+      for(unsigned long i = t; i < queries; i += threads) {
+        //годы 1000..4191 - все позиции пасхального цикла; день определяется номером запроса
+        const int64_t year = 1000 + static_cast<int64_t>(i * 7919 % 3192);
+        const Month m = static_cast<Month>(1 + i % 12);
+        const Day d = static_cast<Day>(1 + i % 28);
+        sink += c.date_properties(year, m, d).size();
+        sink += c.is_date_of(year, m, d, pasha);
+      }
+      if(sink == 0) std::printf(" ");
+    });
+  }
+  for(auto& th: pool) th.join();
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return queries / seconds;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned max_threads = argc > 1 ? std::atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+  const unsigned long queries = argc > 2 ? std::atol(argv[2]) : 400000;
+  OrthodoxCalendar warm;
+  OrthodoxCalendar small;
+  small.set_cache_limit(256 * 1024);
+  throughput(warm, 1, queries);//заполнение кэша
+  std::printf("threads  queries/s  speedup  queries/s (256 KB cache)  speedup\n");
+  double warm_base{}, small_base{};
+  for(unsigned threads = 1; threads <= max_threads; ++threads) {
+    const double w = throughput(warm, threads, queries);
+    const double s = throughput(small, threads, queries / 200);
+    if(threads == 1) {
+      warm_base = w;
+      small_base = s;
+    }
+    std::printf("%7u  %9.0f  %7.2f  %24.0f  %7.2f\n", threads, w, w / warm_base, s, s / small_base);
+  }
+  return 0;
+}
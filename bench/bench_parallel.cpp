@@ -0,0 +1,33 @@
+//время параллельного поиска за период в зависимости от кол-ва потоков исполнителя (1..N).
+//кэш отключен, поэтому каждая задача строит объекты OrthYear своих годов.
+//параметры: [N (по умолчанию std::thread::hardware_concurrency())] [кол-во лет периода (по умолчанию 2000)]
+#include "oxc.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace oxc;
+
+int main(int argc, char* argv[])
+{
+  const unsigned max_threads = argc > 1 ? std::atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+  const unsigned long long years = argc > 2 ? std::atoll(argv[2]) : 2000;
+  const Date d1(2000, 1, 1), d2(2000 + years - 1, 12, 31);
+  const std::vector<uint16_t> properties = {pasha, m3d25, sub_peredbogoyav};
+  double base{};
+  std::printf("threads  seconds  speedup  dates\n");
+  for(unsigned threads = 1; threads <= max_threads; ++threads) {
+    OrthodoxCalendar c;
+    c.set_cache_limit(0);
+    const auto executor = OrthodoxCalendar::thread_executor(threads);
+    const auto start = std::chrono::steady_clock::now();
+    const auto dates = c.get_compact_alldates_inperiod_withanyof(d1, d2, properties, executor);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if(threads == 1) base = seconds;
+    std::printf("%7u  %7.3f  %7.2f  %zu\n", threads, seconds, base / seconds, dates.size());
+  }
+  return 0;
+}
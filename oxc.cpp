@@ -28,17 +28,26 @@
 #include "oxc.h"
 #include <algorithm>                                       // for copy, tran...
 #include <array>                                           // for array, arr...
+#include <atomic>                                          // for atomic
+#include <bit>                                             // for countr_zero
 #include <boost/multiprecision/cpp_int.hpp>                // for cpp_int_ba...
+#include <charconv>                                        // for from_chars
 #include <compare>                                         // for common_com...
+#include <condition_variable>                              // for condition_...
 #include <cstdlib>                                         // for abs, size_t
 #include <exception>                                       // for exception
+#include <functional>                                      // for function
 #include <initializer_list>                                // for initialize...
 #include <iterator>                                        // for back_inser...
 #include <limits>                                          // for numeric_li...
 #include <map>                                             // for operator==
+#include <memory>                                          // for shared_ptr
+#include <mutex>                                           // for unique_lock
 #include <queue>                                           // for queue
 #include <set>                                             // for set
+#include <shared_mutex>                                    // for shared_mutex
 #include <stdexcept>                                       // for runtime_error
+#include <thread>                                          // for jthread
 #include <type_traits>                                     // for enable_if<...
 #include <unordered_map>                                   // for unordered_map
 
@@ -50,9 +59,18 @@
 /*                  CONSTANTS                   */
 /*----------------------------------------------*/
 
-constexpr auto M_COUNT = 12;// day_markers array size
 constexpr auto EMPTY_CJDN = -1;
 constexpr auto MIN_CJDN_VALUE = 1721791;
+// великий индиктион: период повторения пасхалии и дней недели юлианского календаря (19 * 28 лет)
+constexpr auto PASCHAL_CYCLE = 532;
+// кол-во лет в одной задаче параллельного поиска за период
+constexpr int64_t YEARS_PER_TASK = 8;
+// кол-во задач, передаваемых исполнителю за один вызов: промежуточные результаты не зависят от длины периода
+constexpr int64_t TASKS_PER_WAVE = 64;
+// пределы для вычислений в int64_t без переполнения промежуточных значений;
+// за этими пределами используется big_int
+constexpr int64_t MAX_FAST_YEAR = 1'000'000'000'000'000;
+constexpr int64_t MAX_FAST_CJDN = 400'000'000'000'000'000;
 const char* invalid_date = "ошибка определения даты";
 
 /*----------------------------------------------*/
@@ -64,6 +82,88 @@ using ApEvReads = oxc::OrthodoxCalendar::ApostolEvangelieReadings ;
 using big_int = boost::multiprecision::cpp_int;
 using INT = big_int;
 
+/*----------------------------------------------*/
+/*                class BitMask                 */
+/*----------------------------------------------*/
+
+//битовое множество фиксированного размера на массиве 64-битных слов.
+//пересечение и объединение выполняются пословно простыми циклами, которые компилятор векторизует
+template<size_t Bits>
+struct BitMask {
+  static constexpr size_t WORDS = (Bits + 63) / 64;
+  std::array<uint64_t, WORDS> words{};
+
+  void set(size_t i) { words[i/64] |= uint64_t{1} << (i%64); }
+  void reset(size_t i) { words[i/64] &= ~(uint64_t{1} << (i%64)); }
+  bool test(size_t i) const { return words[i/64] & (uint64_t{1} << (i%64)); }
+  size_t count() const
+  {
+    size_t result{};
+    for(auto w: words) result += std::popcount(w);
+    return result;
+  }
+  bool any() const
+  {
+    uint64_t x{};
+    for(auto w: words) x |= w;
+    return x != 0;
+  }
+  BitMask& operator&=(const BitMask& rhs)
+  {
+    for(size_t i=0; i<WORDS; ++i) words[i] &= rhs.words[i];
+    return *this;
+  }
+  BitMask& operator|=(const BitMask& rhs)
+  {
+    for(size_t i=0; i<WORDS; ++i) words[i] |= rhs.words[i];
+    return *this;
+  }
+  //дополнение; биты за пределами Bits в последнем слове также устанавливаются
+  BitMask operator~() const
+  {
+    BitMask result;
+    for(size_t i=0; i<WORDS; ++i) result.words[i] = ~words[i];
+    return result;
+  }
+  //номер первого установленного бита или -1
+  int find_first() const
+  {
+    for(size_t i=0; i<WORDS; ++i)
+      if(words[i]) return i*64 + std::countr_zero(words[i]);
+    return -1;
+  }
+  //номер первого установленного бита после from (from = -1 - от начала) или -1
+  int find_next(int from) const
+  {
+    const size_t start = from + 1;
+    if(start >= WORDS*64) return -1;
+    size_t i = start/64;
+    if(auto w = words[i] & (~uint64_t{} << (start%64)); w) return i*64 + std::countr_zero(w);
+    for(++i; i<WORDS; ++i)
+      if(words[i]) return i*64 + std::countr_zero(words[i]);
+    return -1;
+  }
+  //номер последнего установленного бита перед from (from = WORDS*64 - от конца) или -1
+  int find_prev(int from) const
+  {
+    if(from <= 0) return -1;
+    const size_t end = from - 1;
+    size_t i = end/64;
+    if(auto w = words[i] & (~uint64_t{} >> (63 - end%64)); w) return i*64 + 63 - std::countl_zero(w);
+    while(i-- > 0)
+      if(words[i]) return i*64 + 63 - std::countl_zero(words[i]);
+    return -1;
+  }
+  //вызывает f(номер бита) для всех установленных битов по возрастанию
+  template<typename F>
+    void for_each(F f) const
+  {
+    for(size_t i=0; i<WORDS; ++i)
+      for(auto w = words[i]; w; w &= w - 1) f(i*64 + std::countr_zero(w));
+  }
+  bool operator==(const BitMask& rhs) const = default;
+};
+
 /*----------------------------------------------*/
 /*                  FUNCTIONS                   */
 /*----------------------------------------------*/
@@ -78,6 +178,19 @@ big_int string_to_big_int(const std::string& i)
   return res;
 }
 
+std::optional<int64_t> string_to_fast_int(const std::string& i)
+{ // только десятичная запись без ведущих нулей; прочие форматы разбирает big_int
+  const char* first = i.data();
+  const char* last = i.data() + i.size();
+  const char* digits = (first != last && *first == '-') ? first + 1 : first;
+  if(digits == last || (*digits == '0' && digits + 1 != last)) return std::nullopt;
+  int64_t res;
+  auto [ptr, ec] = std::from_chars(first, last, res);
+  if(ec != std::errc() || ptr != last) return std::nullopt;
+  if(res > MAX_FAST_YEAR || res < -MAX_FAST_YEAR) return std::nullopt;
+  return res;
+}
+
 big_int string_to_year(const std::string& i)
 {
   auto res = string_to_big_int(i);
@@ -86,6 +199,57 @@ big_int string_to_year(const std::string& i)
   return res;
 }
 
+int64_t check_year(const int64_t i)
+{
+  if( i < oxc::MIN_YEAR_VALUE )
+    throw std::out_of_range("выход числа года '"+std::to_string(i)+"' за границу диапазона");
+  return i;
+}
+
+//CJDN 1 января года year по юлианскому календарю
+int64_t julian_year_start(const int64_t year)
+{
+  return 365*(year-1) + (year-1)/4 + 1721424;
+}
+
+//число года по юлианскому календарю для cjdn (обратное к julian_year_start).
+//деление на 4-летние периоды выполняется до умножения, поэтому допустим любой cjdn объекта CompactDate
+int64_t julian_year_of(const int64_t cjdn)
+{
+  const int64_t x = cjdn - 1721424;
+  return 4 * (x / 1461) + (4 * (x % 1461) + 3) / 1461 + 1;
+}
+
+//CJDN даты по юлианскому календарю (метод Dr Louis Strous'a, как в Date::impl::julian2cjdn)
+int64_t julian_to_cjdn(const int64_t year, const int m, const int d)
+{
+  const int64_t c0 = m < 3 ? -1 : 0;
+  return (1461 * (year + c0)) / 4 + (153 * m - 1836 * c0 - 457) / 5 + d + 1721117;
+}
+
+//число года, если оно допускает вычисления в int64_t
+std::optional<int64_t> fast_year(const std::string& year)
+{
+  return string_to_fast_int(year);
+}
+
+std::optional<int64_t> fast_year(const int64_t year)
+{
+  if(year > MAX_FAST_YEAR || year < -MAX_FAST_YEAR) return std::nullopt;
+  return year;
+}
+
+//x + cycles * per_cycle для подсчетов по полным пасхальным циклам; cycles может быть big_int,
+//поэтому результат, не помещающийся в uint64_t, приводит к исключению std::overflow_error
+template<typename Integer>
+  uint64_t add_cycles(const uint64_t x, const Integer& cycles, const uint64_t per_cycle)
+{
+  constexpr auto max = std::numeric_limits<uint64_t>::max();
+  if(per_cycle && big_int(cycles) > (max - x) / per_cycle)
+    throw std::overflow_error("результат подсчета не помещается в uint64_t");
+  return x + static_cast<uint64_t>(cycles) * per_cycle;
+}
+
 namespace oxc {
 
 bool is_leap_year(const Year& y, const CalendarFormat fmt)
@@ -109,6 +273,26 @@ bool is_leap_year(const Year& y, const CalendarFormat fmt)
   }
 }
 
+bool is_leap_year(const int64_t year, const CalendarFormat fmt)
+{
+  switch(fmt){
+    case Grigorian: return (year%400 == 0) || (year%100 != 0 && year%4 == 0) ;
+    case Julian: return (year%4 == 0) ;
+    case Milankovic: {
+      if(year%4 == 0) {
+        if(year%100 == 0) {
+          auto x = std::abs(year/100 % 9);
+          if(x == 2 || x == 6) return true;
+          else return false;
+        }
+        return true;
+      }
+      return false;
+    }
+    default: return false;
+  }
+}
+
 Day month_length(const Month month, const bool leap)
 {
   switch(month) {
@@ -135,9 +319,9 @@ Day month_length(const Month month, const bool leap)
   }
 }
 
-std::string property_title(oxc_const property)
-{
-  static const std::map<uint16_t, std::string_view> table = {
+//таблица всех признаков дней (констант oxc::) с их описанием, упорядоченная по значению константы.
+//индекс элемента таблицы используется как плотный номер признака
+constexpr auto properties_table = std::to_array<std::pair<uint16_t, std::string_view>>({
   //таблица - группа констант 1 - переходящие дни года
     {pasha,              "Светлое Христово Воскресение. ПАСХА."},
     {svetlaya1,          "Понедельник Светлой седмицы."},
@@ -463,41 +647,108 @@ std::string property_title(oxc_const property)
     { sobor_smolensk,          "Собор Смоленских святых"},
     { sobor_alansk,            "Собор Аланских святых"},
     { sobor_german,            "Собор святых, в земле Германской просиявших"}
-  };
-  if(auto x = table.find(property); x!=table.end()) return std::string(x->second);
+});
+static_assert(std::adjacent_find(properties_table.begin(), properties_table.end(),
+      [](const auto& a, const auto& b){ return a.first >= b.first; }) == properties_table.end(),
+      "properties_table must be sorted by property value without duplicates");
+
+constexpr auto PROPERTIES_COUNT = properties_table.size();
+
+//плотный номер признака по значению константы; -1 - неизвестный признак
+constexpr auto property_ids = [] {
+  std::array<int16_t, properties_table.back().first + 1> result;
+  result.fill(-1);
+  for(size_t i=0; i<properties_table.size(); ++i) result[properties_table[i].first] = i;
+  return result;
+}();
+
+int property_id(oxc_const property)
+{
+  return property < property_ids.size() ? property_ids[property] : -1;
+}
+
+std::string property_title(oxc_const property)
+{
+  if(auto i = property_id(property); i>=0) return std::string(properties_table[i].second);
   return {};
 }
 
+//непереходящие даты года (группа констант 2) по юлианскому календарю; индекс - значение константы минус m1d1
+constexpr std::array<ShortDate, oxc::m12d31 - oxc::m1d1 + 1> fixed_dates_table = {{
+  {1,1}, {1,2}, {1,3}, {1,4}, {1,5}, {1,6},
+  {1,7}, {1,8}, {1,9}, {1,10}, {1,11}, {1,12},
+  {1,13}, {1,14}, {3,25}, {6,24}, {6,25}, {6,29},
+  {8,5}, {8,6}, {8,7}, {8,8}, {8,9}, {8,10},
+  {8,11}, {8,12}, {8,13}, {8,14}, {8,15}, {8,16},
+  {8,17}, {8,18}, {8,19}, {8,20}, {8,21}, {8,22},
+  {8,23}, {9,7}, {9,8}, {9,9}, {9,10}, {9,11},
+  {9,12}, {9,13}, {9,14}, {9,15}, {9,16}, {9,17},
+  {9,18}, {9,19}, {9,20}, {9,21}, {8,29}, {10,1},
+  {11,20}, {11,21}, {11,22}, {11,23}, {11,24}, {11,25},
+  {12,20}, {12,21}, {12,22}, {12,23}, {12,24}, {12,25},
+  {12,26}, {12,27}, {12,28}, {12,29}, {12,30}, {12,31}
+}};
+
+//дата непереходящего признака без построения OrthYear; nullopt - признак переходящий
+std::optional<ShortDate> fixed_date_of(oxc_const property)
+{
+  if(property < oxc::m1d1 || property > oxc::m12d31) return std::nullopt;
+  return fixed_dates_table[property - oxc::m1d1];
+}
+
 /*----------------------------------------------*/
 /*              class Date::impl                */
 /*----------------------------------------------*/
 
 class Date::impl {
-  INT cjdn_;                         //Chronological Julian Day Number
-  std::tuple<Year,Month,Day> gdate_; //Grigorian date
-  std::tuple<Year,Month,Day> jdate_; //Julian date
-  std::tuple<Year,Month,Day> mdate_; //Milankovic date
-
-  int fdiv_(int a, int b) const;
+  int64_t cjdn_;                     //Chronological Julian Day Number
+  std::optional<INT> big_cjdn_;      //CJDN > MAX_FAST_CJDN (в этом случае cjdn_ не используется)
+  // дата в том виде, в котором задана (год - исходной строкой); разложения по остальным календарям
+  // вычисляются из cjdn при каждом обращении, поэтому константные методы не изменяют объект
+  std::optional<std::tuple<Year,Month,Day>> given_;
+  CalendarFormat given_fmt_{Julian};
+
+  int64_t fdiv_(int64_t a, int64_t b) const;
   INT fdiv_(const INT& a, const INT& b) const;
   template<typename Integer>
     Integer mod_(const Integer& a, const Integer& b) const;
-  std::pair<int,int> pdiv_(int a, int b) const;
+  std::pair<int64_t,int64_t> pdiv_(int64_t a, int64_t b) const;
   std::pair<INT,INT> pdiv_(const INT& a, const INT& b) const;
-  INT grigorian2cjdn(const Year& y, const Month m, const Day d) const;
-  INT julian2cjdn(const Year& y, const Month m, const Day d) const;
-  INT milankovic2cjdn(const Year& y, const Month m, const Day d) const;
-  std::tuple<Year,Month,Day> cjdn2grigorian(const INT& cjdn) const;
-  std::tuple<Year,Month,Day> cjdn2julian(const INT& cjdn) const;
-  std::tuple<Year,Month,Day> cjdn2milankovic(const INT& cjdn) const;
+  static Year to_year_(int64_t y) { return std::to_string(y); }
+  static Year to_year_(const INT& y) { return y.str(); }
+  template<typename Integer>
+    bool is_leap_(const Integer& year, const CalendarFormat fmt) const;
+  template<typename Integer>
+    Integer grigorian2cjdn(const Integer& year, const Month m, const Day d) const;
+  template<typename Integer>
+    Integer julian2cjdn(const Integer& year, const Month m, const Day d) const;
+  template<typename Integer>
+    Integer milankovic2cjdn(const Integer& year, const Month m, const Day d) const;
+  template<typename Integer>
+    std::tuple<Year,Month,Day> cjdn2grigorian(const Integer& cjdn) const;
+  template<typename Integer>
+    std::tuple<Year,Month,Day> cjdn2julian(const Integer& cjdn) const;
+  template<typename Integer>
+    std::tuple<Year,Month,Day> cjdn2milankovic(const Integer& cjdn) const;
+  template<typename Integer>
+    bool reset_(const Integer& year, const Month m, const Day d, const CalendarFormat f);
+  template<typename Integer>
+    bool reset_(const Integer& new_cjdn);
+  std::tuple<Year,Month,Day> ymd_(const CalendarFormat fmt) const;
 
 public:
   impl();
   impl(const Year& y, const Month m, const Day d, const CalendarFormat f);
+  impl(const unsigned long long y, const Month m, const Day d, const CalendarFormat f);
   impl(const INT& cjdn);
+  impl(const int64_t cjdn);
   bool reset();
   bool reset(const Year& y, const Month m, const Day d, const CalendarFormat f);
+  bool reset(const unsigned long long y, const Month m, const Day d, const CalendarFormat f);
   bool reset(const INT& new_cjdn);
+  bool reset(const int64_t new_cjdn);
+  bool reset_from_incremented_by(const Date::impl& from, unsigned long long c);
+  bool reset_from_decremented_by(const Date::impl& from, unsigned long long c);
   bool operator==(const Date::impl& rhs) const;
   bool operator!=(const Date::impl& rhs) const;
   bool operator<(const Date::impl& rhs) const ;
@@ -511,86 +762,110 @@ public:
   Weekday weekday() const;
   std::tuple<Year,Month,Day> ymd(const CalendarFormat fmt) const;
   INT cjdn() const;
-  INT cjdn_from_incremented_by(unsigned long long c) const;
-  INT cjdn_from_decremented_by(unsigned long long c) const;
+  std::optional<int64_t> cjdn64() const;
   std::string& format(std::string& fmt) const;
 };
 
 bool Date::impl::reset()
 {
-  gdate_ = std::make_tuple<Year,Month,Day>({},{},{});
-  jdate_ = std::make_tuple<Year,Month,Day>({},{},{});
-  mdate_ = std::make_tuple<Year,Month,Day>({},{},{});
+  given_.reset();
   cjdn_ = EMPTY_CJDN;
+  big_cjdn_.reset();
   return true;
 }
 
 bool Date::impl::reset(const Year& y, const Month m, const Day d, const CalendarFormat f)
 {
   if( m<1 || m>12 ) return false;
-  INT x;
-  try { x.assign(y); } catch(const std::exception& e) { return false; }
-  if( x < MIN_YEAR_VALUE ) return false;
-  if( d<1 || d > month_length(m, is_leap_year(y, f)) ) return false;
-  std::tuple<Year,Month,Day> jx, gx, mx ;
+  if(auto x = string_to_fast_int(y); x) {
+    if(!reset_(*x, m, d, f)) return false;
+  } else {
+    INT big;
+    try { big.assign(y); } catch(const std::exception& e) { return false; }
+    if(!reset_(big, m, d, f)) return false;
+  }
+  given_ = std::make_tuple(y, m, d);
+  given_fmt_ = f;
+  return true;
+}
+
+bool Date::impl::reset(const unsigned long long y, const Month m, const Day d, const CalendarFormat f)
+{
+  if( m<1 || m>12 ) return false;
+  if(y <= static_cast<unsigned long long>(MAX_FAST_YEAR)) return reset_(static_cast<int64_t>(y), m, d, f);
+  return reset_(INT(y), m, d, f);
+}
+
+template<typename Integer>
+  bool Date::impl::reset_(const Integer& year, const Month m, const Day d, const CalendarFormat f)
+{
+  if( year < MIN_YEAR_VALUE ) return false;
+  if( d<1 || d > month_length(m, is_leap_(year, f)) ) return false;
+  Integer x;
   switch(f) {
-    case Grigorian: {
-      x = grigorian2cjdn(y, m, d);
-      gx = std::make_tuple(y, m, d);
-      jx = cjdn2julian(x);
-      mx = cjdn2milankovic(x);
-    } break;
-    case Julian: {
-      x = julian2cjdn(y, m, d);
-      jx = std::make_tuple(y, m, d);
-      gx = cjdn2grigorian(x);
-      mx = cjdn2milankovic(x);
-    } break;
-    case Milankovic: {
-      x = milankovic2cjdn(y, m, d);
-      mx = std::make_tuple(y, m, d);
-      gx = cjdn2grigorian(x);
-      jx = cjdn2julian(x);
-    } break;
+    case Grigorian:  x = grigorian2cjdn(year, m, d);  break;
+    case Julian:     x = julian2cjdn(year, m, d);     break;
+    case Milankovic: x = milankovic2cjdn(year, m, d); break;
     default: { return false; }
   }
-  INT jy ( std::get<0>(jx) );
-  INT gy ( std::get<0>(gx) );
-  INT my ( std::get<0>(mx) );
-  if( jy < MIN_YEAR_VALUE || gy < MIN_YEAR_VALUE || my < MIN_YEAR_VALUE ) return false;
-  gdate_ = gx;
-  jdate_ = jx;
-  mdate_ = mx;
-  cjdn_  = x;
+  // MIN_CJDN_VALUE - первый день, год которого не меньше MIN_YEAR_VALUE во всех трех календарях
+  if( x < MIN_CJDN_VALUE ) return false;
+  given_.reset();
+  if( x > MAX_FAST_CJDN ) {
+    big_cjdn_ = INT(x);
+  } else {
+    cjdn_ = static_cast<int64_t>(x);
+    big_cjdn_.reset();
+  }
   return true;
 }
 
 bool Date::impl::reset(const INT& new_cjdn)
+{
+  if(new_cjdn <= MAX_FAST_CJDN) return reset(static_cast<int64_t>(new_cjdn));
+  return reset_(new_cjdn);
+}
+
+bool Date::impl::reset(const int64_t new_cjdn)
+{
+  if(new_cjdn > MAX_FAST_CJDN) return reset_(INT(new_cjdn));
+  return reset_(new_cjdn);
+}
+
+template<typename Integer>
+  bool Date::impl::reset_(const Integer& new_cjdn)
 {
   if(new_cjdn == EMPTY_CJDN) {
-    cjdn_  = EMPTY_CJDN ;
-    gdate_ = std::make_tuple<Year,Month,Day>({},{},{});
-    jdate_ = std::make_tuple<Year,Month,Day>({},{},{});
-    mdate_ = std::make_tuple<Year,Month,Day>({},{},{});
+    reset();
   } else {
     if(new_cjdn < MIN_CJDN_VALUE) return false;
-    auto jx = cjdn2julian(new_cjdn);
-    INT jy ( std::get<0>(jx) );
-    if( jy < MIN_YEAR_VALUE ) return false;
-    auto gx = cjdn2grigorian(new_cjdn);
-    INT gy ( std::get<0>(gx) );
-    if( gy < MIN_YEAR_VALUE ) return false;
-    auto mx = cjdn2milankovic(new_cjdn);
-    INT my ( std::get<0>(mx) );
-    if( my < MIN_YEAR_VALUE ) return false;
-    gdate_ = gx;
-    jdate_ = jx;
-    mdate_ = mx;
-    cjdn_ = new_cjdn;
+    given_.reset();
+    if constexpr (std::is_same_v<Integer, INT>) {
+      big_cjdn_ = new_cjdn;
+    } else {
+      cjdn_ = new_cjdn;
+      big_cjdn_.reset();
+    }
   }
   return true;
 }
 
+bool Date::impl::reset_from_incremented_by(const Date::impl& from, unsigned long long c)
+{
+  if(!from.big_cjdn_ && c <= static_cast<unsigned long long>(MAX_FAST_CJDN - from.cjdn_))
+    return reset(from.cjdn_ + static_cast<int64_t>(c));
+  return reset(from.cjdn() + c);
+}
+
+bool Date::impl::reset_from_decremented_by(const Date::impl& from, unsigned long long c)
+{
+  if(!from.big_cjdn_) {
+    if(c > static_cast<unsigned long long>(from.cjdn_ + 1)) return false;
+    return reset(from.cjdn_ - static_cast<int64_t>(c));
+  }
+  return reset(from.cjdn() - c);
+}
+
 Date::impl::impl()
 {
   reset();
@@ -602,13 +877,26 @@ Date::impl::impl(const Year& y, const Month m, const Day d, const CalendarFormat
     throw std::runtime_error(std::string(invalid_date)+" '"+y+'.'+std::to_string(m)+'.'+std::to_string(d)+'\'');
 }
 
+Date::impl::impl(const unsigned long long y, const Month m, const Day d, const CalendarFormat f)
+{
+  if(!reset(y, m, d, f))
+    throw std::runtime_error(std::string(invalid_date)+" '"+std::to_string(y)+'.'+std::to_string(m)+'.'
+                              +std::to_string(d)+'\'');
+}
+
 Date::impl::impl(const INT& cjdn)
 {
   if(!reset(cjdn))
     throw std::runtime_error(std::string(invalid_date)+" : cjdn = "+cjdn.str());
 }
 
-int Date::impl::fdiv_(int a, int b) const
+Date::impl::impl(const int64_t cjdn)
+{
+  if(!reset(cjdn))
+    throw std::runtime_error(std::string(invalid_date)+" : cjdn = "+std::to_string(cjdn));
+}
+
+int64_t Date::impl::fdiv_(int64_t a, int64_t b) const
 {//floor division
   return (a - (a < 0 ? b - 1 : 0)) / b;
 }
@@ -631,19 +919,20 @@ template<typename Integer>
   return a - fdiv_(a, b) * b;
 }
 
-std::pair<int,int> Date::impl::pdiv_(int a, int b) const
+std::pair<int64_t,int64_t> Date::impl::pdiv_(int64_t a, int64_t b) const
 {//positive remainder division
-  std::div_t rv = std::div(a, b);
-  if(rv.rem < 0) {
+  int64_t quotient = a / b;
+  int64_t remainder = a % b;
+  if(remainder < 0) {
       if(b>0) {
-          rv.quot -= 1;
-          rv.rem += b;
+          quotient -= 1;
+          remainder += b;
       } else {
-          rv.quot += 1;
-          rv.rem -= b;
+          quotient += 1;
+          remainder -= b;
       }
   }
-  return {rv.quot, rv.rem};
+  return {quotient, remainder};
 }
 
 std::pair<INT,INT> Date::impl::pdiv_(const INT& a, const INT& b) const
@@ -662,100 +951,126 @@ std::pair<INT,INT> Date::impl::pdiv_(const INT& a, const INT& b) const
   return {quotient, remainder};
 }
 
-INT Date::impl::grigorian2cjdn(const Year& y, const Month m, const Day d) const
+template<typename Integer>
+  bool Date::impl::is_leap_(const Integer& year, const CalendarFormat fmt) const
+{
+  switch(fmt){
+    case Grigorian: return (year%400 == 0) || (year%100 != 0 && year%4 == 0) ;
+    case Julian: return (year%4 == 0) ;
+    case Milankovic: {
+      if(year%4 == 0) {
+        if(year%100 == 0) {
+          int x = static_cast<int>(fdiv_(year, Integer(100)) % 9);
+          if(x == 2 || x == 6) return true;
+          else return false;
+        }
+        return true;
+      }
+      return false;
+    }
+    default: return false;
+  }
+}
+
+template<typename Integer>
+  Integer Date::impl::grigorian2cjdn(const Integer& year, const Month m, const Day d) const
 // Dr Louis Strous's method:
 // https://aa.quae.nl/en/reken/juliaansedag.html#3_1
 {
-  INT year = string_to_big_int(y);
-  int c0 = fdiv_((m - 3) , 12);
-  INT x1 = INT(m) - INT(12) * INT(c0) - INT(3);
-  INT x4 = year + c0;
-  auto [x3, x2] = pdiv_(x4, INT(100));
-  INT result = d + 1721119;
-  result += fdiv_( INT(146097) * x3, INT(4) ) ;
-  result += fdiv_( INT(36525) * x2, INT(100) ) ;
-  result += fdiv_( INT(153) * x1 + INT(2), INT(5) ) ;
+  int64_t c0 = fdiv_((m - 3) , 12);
+  int64_t x1 = m - 12 * c0 - 3;
+  Integer x4 = year + c0;
+  auto [x3, x2] = pdiv_(x4, Integer(100));
+  Integer result = Integer(d + 1721119);
+  result += fdiv_( Integer(146097) * x3, Integer(4) ) ;
+  result += fdiv_( Integer(36525) * x2, Integer(100) ) ;
+  result += fdiv_( 153 * x1 + 2, 5 ) ;
   return result;
 }
 
-INT Date::impl::julian2cjdn(const Year& y, const Month m, const Day d) const
+template<typename Integer>
+  Integer Date::impl::julian2cjdn(const Integer& year, const Month m, const Day d) const
 // Dr Louis Strous's method:
 // https://aa.quae.nl/en/reken/juliaansedag.html#5_1
 {
-  INT year = string_to_big_int(y);
-  int c0 = fdiv_((m - 3) , 12);
-  INT j1 = fdiv_(INT(1461) * (year + INT(c0)), INT(4));
-  int j2 = fdiv_(153 * m - 1836 * c0 - 457, 5);
-  INT result = j1 + j2 + d + 1721117;
+  int64_t c0 = fdiv_((m - 3) , 12);
+  Integer j1 = fdiv_(Integer(1461) * (year + c0), Integer(4));
+  int64_t j2 = fdiv_(153 * m - 1836 * c0 - 457, 5);
+  Integer result = j1 + (j2 + d + 1721117);
   return result;
 }
 
-INT Date::impl::milankovic2cjdn(const Year& y, const Month m, const Day d) const
+template<typename Integer>
+  Integer Date::impl::milankovic2cjdn(const Integer& year, const Month m, const Day d) const
 // Dr Louis Strous's method:
 // https://aa.quae.nl/en/reken/juliaansedag.html#4_1
 {
-  INT year = string_to_big_int(y);
-  int c0 = fdiv_((m - 3) , 12);
-  INT x4 = year + c0;
-  INT x3 = fdiv_(x4, INT(100));
-  int x2 = static_cast<int>(mod_(x4, INT(100)));
-  int x1 = m - c0*12 - 3;
-  INT result = d + 1721119;
-  result += fdiv_( INT(328718) * x3 + INT(6), INT(9) ) ;
-  result += fdiv_( INT(36525) * x2, INT(100) ) ;
+  int64_t c0 = fdiv_((m - 3) , 12);
+  Integer x4 = year + c0;
+  Integer x3 = fdiv_(x4, Integer(100));
+  int64_t x2 = static_cast<int64_t>(mod_(x4, Integer(100)));
+  int64_t x1 = m - c0*12 - 3;
+  Integer result = Integer(d + 1721119);
+  result += fdiv_( Integer(328718) * x3 + 6, Integer(9) ) ;
+  result += fdiv_( 36525 * x2, 100 ) ;
   result += fdiv_( 153 * x1 + 2, 5 ) ;
   return result;
 }
 
-std::tuple<Year,Month,Day> Date::impl::cjdn2grigorian(const INT& cjdn) const
+template<typename Integer>
+  std::tuple<Year,Month,Day> Date::impl::cjdn2grigorian(const Integer& cjdn) const
 // Dr Louis Strous's method:
 // https://aa.quae.nl/en/reken/juliaansedag.html#3_2
 {
-  auto [x3, r3] = pdiv_( INT(4) * cjdn - INT(6884477), INT(146097) ) ;
-  auto [x2, r2] = pdiv_( 100 * fdiv_(static_cast<int>(r3), 4) + 99, 36525 ) ;
+  auto [x3, r3] = pdiv_( Integer(4) * cjdn - 6884477, Integer(146097) ) ;
+  auto [x2, r2] = pdiv_( 100 * fdiv_(static_cast<int64_t>(r3), 4) + 99, 36525 ) ;
   auto [x1, r1] = pdiv_( 5 * fdiv_(r2, 100) + 2, 153 ) ;
-  int c0 = fdiv_(x1 + 2, 12);
+  int64_t c0 = fdiv_(x1 + 2, 12);
   Day d = fdiv_(r1, 5) + 1;
   Month m = x1 - 12 * c0 + 3;
-  INT y = x3*100 + x2 + c0;
-  return std::make_tuple(y.str(), m, d);
+  Integer y = x3*100 + (x2 + c0);
+  return std::make_tuple(to_year_(y), m, d);
 }
 
-std::tuple<Year,Month,Day> Date::impl::cjdn2julian(const INT& cjdn) const
+template<typename Integer>
+  std::tuple<Year,Month,Day> Date::impl::cjdn2julian(const Integer& cjdn) const
 // Dr Louis Strous's method:
 // https://aa.quae.nl/en/reken/juliaansedag.html#5_2
 {
-  INT y2 = cjdn - 1721118;
-  INT k2 = y2*4 + 3;
-  int k1 = 5 * fdiv_(static_cast<int>(mod_(k2, INT(1461))), 4) + 2;
-  int x1 = fdiv_(k1, 153);
-  int c0 = fdiv_(x1 + 2, 12);
-  INT y = fdiv_(k2, INT(1461)) + c0;
+  Integer y2 = cjdn - 1721118;
+  Integer k2 = y2*4 + 3;
+  int64_t k1 = 5 * fdiv_(static_cast<int64_t>(mod_(k2, Integer(1461))), 4) + 2;
+  int64_t x1 = fdiv_(k1, 153);
+  int64_t c0 = fdiv_(x1 + 2, 12);
+  Integer y = fdiv_(k2, Integer(1461)) + c0;
   Month m = x1 - 12 * c0 + 3;
-  Day d = fdiv_(mod_(k1, 153), 5) + 1;
-  return std::make_tuple(y.str(), m, d);
+  Day d = fdiv_(mod_(k1, int64_t(153)), 5) + 1;
+  return std::make_tuple(to_year_(y), m, d);
 }
 
-std::tuple<Year,Month,Day> Date::impl::cjdn2milankovic(const INT& cjdn) const
+template<typename Integer>
+  std::tuple<Year,Month,Day> Date::impl::cjdn2milankovic(const Integer& cjdn) const
 // Dr Louis Strous's method:
 // https://aa.quae.nl/en/reken/juliaansedag.html#4_2
 {
-  INT k3 = INT(9) * (cjdn - INT(1721120)) + 2;
-  INT x3 = fdiv_(k3, INT(328718));
-  int k2 = 100 * fdiv_(static_cast<int>(mod_(k3, INT(328718))), 9) + 99;
-  int x2 = fdiv_(k2, 36525);
-  int k1 = fdiv_(mod_(k2, 36525), 100) * 5 + 2;
-  int x1 = fdiv_(k1, 153);
-  int c0 = fdiv_(x1 + 2, 12);
-  INT y = x3*100 + x2 + c0;
+  Integer k3 = Integer(9) * (cjdn - 1721120) + 2;
+  Integer x3 = fdiv_(k3, Integer(328718));
+  int64_t k2 = 100 * fdiv_(static_cast<int64_t>(mod_(k3, Integer(328718))), 9) + 99;
+  int64_t x2 = fdiv_(k2, 36525);
+  int64_t k1 = fdiv_(mod_(k2, int64_t(36525)), 100) * 5 + 2;
+  int64_t x1 = fdiv_(k1, 153);
+  int64_t c0 = fdiv_(x1 + 2, 12);
+  Integer y = x3*100 + (x2 + c0);
   Month m = x1 - 12 * c0 + 3;
-  Day d = fdiv_(mod_(k1, 153), 5) + 1;
-  return std::make_tuple(y.str(), m, d);
+  Day d = fdiv_(mod_(k1, int64_t(153)), 5) + 1;
+  return std::make_tuple(to_year_(y), m, d);
 }
 
 bool Date::impl::operator==(const Date::impl& rhs) const
 {
-  return cjdn_==rhs.cjdn_;
+  if(!big_cjdn_ && !rhs.big_cjdn_) return cjdn_==rhs.cjdn_;
+  if(big_cjdn_ && rhs.big_cjdn_) return *big_cjdn_==*rhs.big_cjdn_;
+  return false;
 }
 
 bool Date::impl::operator!=(const Date::impl& rhs) const
@@ -765,126 +1080,98 @@ bool Date::impl::operator!=(const Date::impl& rhs) const
 
 bool Date::impl::operator<(const Date::impl& rhs) const
 {
-  return cjdn_<rhs.cjdn_;
+  if(!big_cjdn_ && !rhs.big_cjdn_) return cjdn_<rhs.cjdn_;
+  if(big_cjdn_ && rhs.big_cjdn_) return *big_cjdn_<*rhs.big_cjdn_;
+  return !big_cjdn_;//значение big_cjdn_ всегда больше любого cjdn_
 }
 
 bool Date::impl::operator<=(const Date::impl& rhs) const
 {
-  return cjdn_<=rhs.cjdn_;
+  return !(rhs<*this);
 }
 
 bool Date::impl::operator>(const Date::impl& rhs) const
 {
-  return cjdn_>rhs.cjdn_;
+  return rhs<*this;
 }
 
 bool Date::impl::operator>=(const Date::impl& rhs) const
 {
-  return cjdn_>=rhs.cjdn_;
+  return !(*this<rhs);
 }
 
 bool Date::impl::is_valid() const
 {
-  return cjdn_ != EMPTY_CJDN;
+  return big_cjdn_ || cjdn_ != EMPTY_CJDN;
 }
 
 Year Date::impl::year(const CalendarFormat fmt) const
 {
-  Year result {};
-  switch(fmt){
-    case Grigorian: {
-      result = std::get<0>(gdate_);
-    } break;
-    case Julian: {
-      result = std::get<0>(jdate_);
-    } break;
-    case Milankovic: {
-      result = std::get<0>(mdate_);
-    } break;
-    default: {}
-  }
-  return result;
+  return std::get<0>(ymd_(fmt));
 }
 
 Month Date::impl::month(const CalendarFormat fmt) const
 {
-  Month result {};
-  switch(fmt){
-    case Grigorian: {
-      result = std::get<1>(gdate_);
-    } break;
-    case Julian: {
-      result = std::get<1>(jdate_);
-    } break;
-    case Milankovic: {
-      result = std::get<1>(mdate_);
-    } break;
-    default: {}
-  }
-  return result;
+  return std::get<1>(ymd_(fmt));
 }
 
 Day Date::impl::day(const CalendarFormat fmt) const
 {
-  Day result {};
-  switch(fmt){
-    case Grigorian: {
-      result = std::get<2>(gdate_);
-    } break;
-    case Julian: {
-      result = std::get<2>(jdate_);
-    } break;
-    case Milankovic: {
-      result = std::get<2>(mdate_);
-    } break;
-    default: {}
-  }
-  return result;
+  return std::get<2>(ymd_(fmt));
 }
 
 Weekday Date::impl::weekday() const
 {
   if(!is_valid()) return -1;
-  return boost::multiprecision::integer_modulus(cjdn_ + 1, 7);
+  if(big_cjdn_) return boost::multiprecision::integer_modulus(*big_cjdn_ + 1, 7);
+  return (cjdn_ + 1) % 7;
 }
 
 std::tuple<Year,Month,Day> Date::impl::ymd(const CalendarFormat fmt) const
 {
+  return ymd_(fmt);
+}
+
+std::tuple<Year,Month,Day> Date::impl::ymd_(const CalendarFormat fmt) const
+{
+  if(!is_valid()) return {};
+  if(given_ && given_fmt_ == fmt) return *given_;
   switch(fmt) {
-    case Grigorian:  return gdate_ ;
-    case Julian:     return jdate_ ;
-    case Milankovic: return mdate_ ;
+    case Grigorian:  return big_cjdn_ ? cjdn2grigorian(*big_cjdn_) : cjdn2grigorian(cjdn_);
+    case Julian:     return big_cjdn_ ? cjdn2julian(*big_cjdn_) : cjdn2julian(cjdn_);
+    case Milankovic: return big_cjdn_ ? cjdn2milankovic(*big_cjdn_) : cjdn2milankovic(cjdn_);
   }
-  return std::make_tuple<Year,Month,Day>({},{},{}) ;
+  return {};
 }
 
 INT Date::impl::cjdn() const
 {
+  if(big_cjdn_) return *big_cjdn_;
   return cjdn_ ;
 }
 
-INT Date::impl::cjdn_from_incremented_by(unsigned long long c) const
-{
-  return cjdn_ + c;
-}
-
-INT Date::impl::cjdn_from_decremented_by(unsigned long long c) const
+std::optional<int64_t> Date::impl::cjdn64() const
 {
-  return cjdn_ - c;
+  if(!big_cjdn_) return cjdn_;
+  if(*big_cjdn_ > std::numeric_limits<int64_t>::max()) return std::nullopt;
+  return static_cast<int64_t>(*big_cjdn_);
 }
 
 std::string& Date::impl::format(std::string& fmt) const
 {
   if(fmt.size() < 3) return fmt;
-  std::string gy_ = std::get<0>(gdate_);
-  std::string gm_ = std::to_string(std::get<1>(gdate_));
-  std::string gd_ = std::to_string(std::get<2>(gdate_));
-  std::string jy_ = std::get<0>(jdate_);
-  std::string jm_ = std::to_string(std::get<1>(jdate_));
-  std::string jd_ = std::to_string(std::get<2>(jdate_));
-  std::string my_ = std::get<0>(mdate_);
-  std::string mm_ = std::to_string(std::get<1>(mdate_));
-  std::string md_ = std::to_string(std::get<2>(mdate_));
+  const auto gdate = ymd_(Grigorian);
+  const auto jdate = ymd_(Julian);
+  const auto mdate = ymd_(Milankovic);
+  std::string gy_ = std::get<0>(gdate);
+  std::string gm_ = std::to_string(std::get<1>(gdate));
+  std::string gd_ = std::to_string(std::get<2>(gdate));
+  std::string jy_ = std::get<0>(jdate);
+  std::string jm_ = std::to_string(std::get<1>(jdate));
+  std::string jd_ = std::to_string(std::get<2>(jdate));
+  std::string my_ = std::get<0>(mdate);
+  std::string mm_ = std::to_string(std::get<1>(mdate));
+  std::string md_ = std::to_string(std::get<2>(mdate));
   auto replacement = [this, &jy_, &gy_, &my_, &jm_, &gm_, &mm_, &jd_, &gd_, &md_](const std::string& c)->std::string{
     if(c=="%%")      { return "%"; }
     else if(c=="JY") { return jy_; }
@@ -1030,7 +1317,7 @@ std::string& Date::impl::format(std::string& fmt) const
 
 /*static*/bool Date::check(const unsigned long long y, const Month m, const Day d, const CalendarFormat fmt)
 {
-  return check(std::to_string(y), m, d, fmt);
+  return Date::impl().reset(y, m, d, fmt);
 }
 
 Date::Date() : pimpl(new Date::impl())
@@ -1043,7 +1330,11 @@ Date::Date(const Year& y, const Month m, const Day d, const CalendarFormat fmt)
 }
 
 Date::Date(const unsigned long long y, const Month m, const Day d, const CalendarFormat fmt)
-  : pimpl(new Date::impl(std::to_string(y), m, d, fmt))
+  : pimpl(new Date::impl(y, m, d, fmt))
+{
+}
+
+Date::Date(const CompactDate& d) : pimpl(new Date::impl(d.cjdn()))
 {
 }
 
@@ -1135,32 +1426,16 @@ std::tuple<Year,Month,Day> Date::ymd(const CalendarFormat fmt) const
 
 Date Date::inc_by_days(unsigned long long c) const
 {
-  try
-  {
-    auto new_pimpl = std::make_unique<Date::impl>(pimpl->cjdn_from_incremented_by(c)) ;
-    Date result;
-    result.pimpl.swap(new_pimpl);
-    return result;
-  }
-  catch(const std::exception& e)
-  {
-    return {};
-  }
+  Date result;
+  if(!result.pimpl->reset_from_incremented_by(*pimpl, c)) return {};
+  return result;
 }
 
 Date Date::dec_by_days(unsigned long long c) const
 {
-  try
-  {
-    auto new_pimpl = std::make_unique<Date::impl>(pimpl->cjdn_from_decremented_by(c)) ;
-    Date result;
-    result.pimpl.swap(new_pimpl);
-    return result;
-  }
-  catch(const std::exception& e)
-  {
-    return {};
-  }
+  Date result;
+  if(!result.pimpl->reset_from_decremented_by(*pimpl, c)) return {};
+  return result;
 }
 
 bool Date::reset(const Year& y, const Month m, const Day d, const CalendarFormat fmt)
@@ -1171,7 +1446,7 @@ bool Date::reset(const Year& y, const Month m, const Day d, const CalendarFormat
 
 bool Date::reset(const unsigned long long y, const Month m, const Day d, const CalendarFormat fmt)
 {
-  return reset(std::to_string(y), m, d, fmt);
+  return pimpl->reset(y, m, d, fmt);
 }
 
 std::string Date::format(std::string fmt) const
@@ -1180,98 +1455,269 @@ std::string Date::format(std::string fmt) const
 }
 
 /*----------------------------------------------*/
-/*              class OrthYear                  */
+/*              class CompactDate               */
 /*----------------------------------------------*/
 
-class OrthYear {
+static_assert(std::is_trivially_copyable_v<CompactDate> && sizeof(CompactDate) == sizeof(int64_t));
 
-  ShortDate pasha_calc(const big_int& year)
-  { //use Gauss method for julian calendar
-    int8_t m_=3, p;
-    unsigned a, b, c, d, e;
-    a = static_cast<unsigned>(year % 19);
-    b = static_cast<unsigned>(year % 4);
-    c = static_cast<unsigned>(year % 7);
-    d = (19*a+15) % 30;
-    e = (2*b+4*c+6*d+6) % 7;
-    p = 22 + d + e;
-    if(p>31) {
-      p = d + e - 9;
-      m_ = 4;
-    }
-    return std::make_pair(m_, p);
-  }
+/*static*/CompactDate CompactDate::from_cjdn(int64_t cjdn)
+{
+  if(cjdn != EMPTY_CJDN && cjdn < MIN_CJDN_VALUE)
+    throw std::runtime_error(std::string(invalid_date)+" : cjdn = "+std::to_string(cjdn));
+  return CompactDate(cjdn);
+}
 
-  struct Data1 {
-    int8_t dn{-1};
-    int8_t glas{-1};
-    int8_t n50{-1};
-    int8_t day{};
-    int8_t month{};
-    ApEvReads apostol;
-    ApEvReads evangelie;
-    std::array<uint16_t, M_COUNT> day_markers{};//sorted array
-    bool operator<(const Data1& rhs) const
-    {
-      return ShortDate{month, day} < ShortDate{rhs.month, rhs.day};
-    }
-    bool operator==(const Data1& rhs) const = default;
-    bool operator<(const ShortDate& rhs) const
-    {
-      return ShortDate{month, day} < rhs;
-    }
-    bool operator==(const ShortDate& rhs) const
-    {
-      return ShortDate{month, day} == rhs;
-    }
+CompactDate::CompactDate(const Year& y, const Month m, const Day d, const CalendarFormat fmt)
+  : CompactDate(Date::impl(y, m, d, fmt).cjdn64().value_or(EMPTY_CJDN))
+{
+  if(empty()) throw std::out_of_range(std::string(invalid_date)+" '"+y+'.'+std::to_string(m)+'.'+std::to_string(d)+'\'');
+}
+
+CompactDate::CompactDate(const unsigned long long y, const Month m, const Day d, const CalendarFormat fmt)
+  : CompactDate(Date::impl(y, m, d, fmt).cjdn64().value_or(EMPTY_CJDN))
+{
+  if(empty()) throw std::out_of_range(std::string(invalid_date)+" '"+std::to_string(y)+'.'+std::to_string(m)+'.'
+                                      +std::to_string(d)+'\'');
+}
+
+CompactDate::CompactDate(const Date& d) : cjdn_(EMPTY_CJDN)
+{
+  if(!d) return;
+  if(auto x = d.pimpl->cjdn64(); x) cjdn_ = *x;
+  else throw std::out_of_range(std::string(invalid_date)+" : cjdn = "+d.pimpl->cjdn().str());
+}
+
+/*----------------------------------------------*/
+/*              class DatePredicate             */
+/*----------------------------------------------*/
+
+//условие в постфиксной записи: элементарные условия помещают маску дней в стек, операции комбинируют вершину стека
+struct DatePredicate::plan {
+  enum class Code : uint8_t { property, weekday, glas, n50, op_and, op_or, op_not };
+  struct Op {
+    Code code;
+    int16_t arg;//для property - плотный номер признака (-1 - неизвестный признак)
   };
+  std::vector<Op> ops;
+  std::size_t depth{};//глубина стека, необходимая для вычисления
+
+  static DatePredicate atom(Code code, int16_t arg)
+  {
+    auto x = std::make_shared<plan>();
+    x->ops.push_back({code, arg});
+    x->depth = 1;
+    return DatePredicate(std::move(x));
+  }
+  static DatePredicate combine(const plan& lhs, const plan& rhs, Code code)
+  {
+    auto x = std::make_shared<plan>();
+    x->ops.reserve(lhs.ops.size() + rhs.ops.size() + 1);
+    x->ops = lhs.ops;
+    x->ops.insert(x->ops.end(), rhs.ops.begin(), rhs.ops.end());
+    x->ops.push_back({code, 0});
+    x->depth = std::max(lhs.depth, rhs.depth + 1);
+    return DatePredicate(std::move(x));
+  }
+};
+
+/*static*/DatePredicate DatePredicate::property(oxc_const property)
+{
+  return plan::atom(plan::Code::property, static_cast<int16_t>(property_id(property)));
+}
+
+/*static*/DatePredicate DatePredicate::weekday(Weekday w)
+{
+  return plan::atom(plan::Code::weekday, w);
+}
+
+/*static*/DatePredicate DatePredicate::glas(int8_t g)
+{
+  return plan::atom(plan::Code::glas, g);
+}
+
+/*static*/DatePredicate DatePredicate::n50(int8_t n)
+{
+  return plan::atom(plan::Code::n50, n);
+}
+
+DatePredicate operator&(const DatePredicate& lhs, const DatePredicate& rhs)
+{
+  return DatePredicate::plan::combine(*lhs.p, *rhs.p, DatePredicate::plan::Code::op_and);
+}
+
+DatePredicate operator|(const DatePredicate& lhs, const DatePredicate& rhs)
+{
+  return DatePredicate::plan::combine(*lhs.p, *rhs.p, DatePredicate::plan::Code::op_or);
+}
+
+DatePredicate operator!(const DatePredicate& x)
+{
+  auto result = std::make_shared<DatePredicate::plan>(*x.p);
+  result->ops.push_back({DatePredicate::plan::Code::op_not, 0});
+  return DatePredicate(std::move(result));
+}
+
+/*----------------------------------------------*/
+/*              class OrthYear                  */
+/*----------------------------------------------*/
+
+class OrthYear {
+
+  template<typename Integer>
+    static ShortDate pasha_calc(const Integer& year)
+  { //use Gauss method for julian calendar
+    int8_t m_=3, p;
+    unsigned a, b, c, d, e;
+    a = static_cast<unsigned>(year % 19);
+    b = static_cast<unsigned>(year % 4);
+    c = static_cast<unsigned>(year % 7);
+    d = (19*a+15) % 30;
+    e = (2*b+4*c+6*d+6) % 7;
+    p = 22 + d + e;
+    if(p>31) {
+      p = d + e - 9;
+      m_ = 4;
+    }
+    return std::make_pair(m_, p);
+  }
+
+public:
 
-  struct Data2 {
-    uint16_t marker{};
+  using PropertyMask = BitMask<PROPERTIES_COUNT>;//индекс бита - плотный номер признака
+  using DayMask = BitMask<366>;//индекс бита - номер дня в году (от 0)
+
+private:
+
+  struct Data1 {
+    int8_t dn{-1};
+    int8_t glas{-1};
+    int8_t n50{-1};
     int8_t day{};
     int8_t month{};
-    bool operator<(const Data2& rhs) const
-    {
-      return marker < rhs.marker;
-    }
-    bool operator==(const Data2& rhs) const = default;
-    bool operator<(oxc_const rhs) const
-    {
-      return marker < rhs;
-    }
-    bool operator==(oxc_const rhs) const
-    {
-      return marker == rhs;
-    }
-    friend bool operator<(oxc_const lhs, const Data2& rhs)
-    {
-      return lhs < rhs.marker;
-    }
+    ApEvReads apostol;
+    ApEvReads evangelie;
+    PropertyMask day_markers;
+    bool operator==(const Data1& rhs) const = default;
   };
 
-  std::vector<Data1> data1;//sorted array
-  std::vector<Data2> data2;//sorted array
+  //номер первого дня месяца в году (от 0); [0] - простой год, [1] - високосный. последний элемент - длина года
+  static constexpr std::array<std::array<int16_t, 13>, 2> month_offsets = {{
+    {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365},
+    {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366}
+  }};
+  std::array<Data1, 366> data1;//индекс - номер дня в году (от 0)
+  std::array<DayMask, PROPERTIES_COUNT> property_days;//индекс - плотный номер признака
+  //номера дней каждого признака в порядке их расчета; дни признака с плотным номером id
+  //занимают [marker_offsets[id], marker_offsets[id+1])
+  std::vector<int16_t> marker_days;
+  std::array<uint16_t, PROPERTIES_COUNT+1> marker_offsets{};
   int8_t winter_indent;
   int8_t spring_indent;
-  big_int y;
+  bool leap;
+
+  //параметры года, от которых зависит весь расчет: даты пасхи и високосность текущего и предыдущего года
+  struct YearTraits {
+    ShortDate pasha;
+    ShortDate pasha_pred;
+    bool leap;
+    bool leap_pred;
+  };
+  template<typename Integer>
+    static YearTraits year_traits(const Integer& year)
+  {
+    return { pasha_calc(year), pasha_calc(year-1), (year%4)==0, ((year-1)%4)==0 };
+  }
+  OrthYear(const YearTraits& traits, std::span<const uint8_t> il, bool osen_otstupka_apostol);
+
+  //таблицы рядовых чтений на литургии
+  using TT1 = std::array<std::array<ApEvReads, 7>, 37>;
+  using TT2 = std::map<uint16_t, ApEvReads>;
+  static const TT1& evangelie_table_1();
+  static const TT1& apostol_table_1();
+  static const TT2& evangelie_table_2();
+  static const TT2& apostol_table_2();
+  //воскресное утреннее евангелие по номеру по пятидесятнице дня и его признакам; has_marker(m) - есть ли у дня признак m
+  template<typename HasMarker>
+    static ApEvReads resurrect_evangelie(int8_t n50, HasMarker has_marker);
+  friend class DayEvaluator;
+
+  static int day_of_year(int8_t m, int8_t d, bool leap)
+  { //номер дня в году (от 0) или -1 для некорректной даты
+    if(m<1 || m>12 || d<1) return -1;
+    const auto& offsets = month_offsets[leap];
+    const int i = offsets[m-1] + d - 1;
+    return i < offsets[m] ? i : -1;
+  }
+
+  const Data1* find_in_data1(int8_t m, int8_t d) const
+  {
+    const int i = day_of_year(m, d, leap);
+    if(i < 0 || data1[i].day == 0) return nullptr;
+    return &data1[i];
+  }
 
-  std::optional<decltype(data1)::const_iterator> find_in_data1(int8_t m, int8_t d) const
+  //маска всех дней года
+  DayMask year_days() const
   {
-    auto dd = ShortDate{m, d};
-    auto fr = std::lower_bound(data1.begin(), data1.end(), dd);
-    if(fr==data1.end()) return std::nullopt;
-    if( !(*fr==dd) ) return std::nullopt;
-    return fr;
+    DayMask days;
+    for(int i=0; i<month_offsets[leap][12]; ++i) days.set(i);
+    return days;
+  }
+  //маска дней, у которых поле field равно value
+  DayMask days_of(int8_t Data1::*field, int8_t value) const
+  {
+    DayMask days;
+    for(int i=0; i<month_offsets[leap][12]; ++i) if(data1[i].*field == value) days.set(i);
+    return days;
   }
 
 public:
 
-  OrthYear(const std::string& year, std::span<const uint8_t> il, bool osen_otstupka_apostol);
+  OrthYear(const std::string& year, std::span<const uint8_t> il, bool osen_otstupka_apostol)
+    : OrthYear(year_traits(string_to_year(year)), il, osen_otstupka_apostol) {}
+  OrthYear(const int64_t year, std::span<const uint8_t> il, bool osen_otstupka_apostol)
+    : OrthYear(year_traits(check_year(year)), il, osen_otstupka_apostol) {}
   OrthYear(const std::string& year, bool o)
     : OrthYear(year, std::array<uint8_t,17>{33,32,33,31,32,33,30,31,32,33,30,31,17,32,33,10,11}, o) {}
   OrthYear(const std::string& year): OrthYear(year, false) {}
   OrthYear(const std::string& year, std::span<const uint8_t> il): OrthYear(year, il, false) {}
 
+  //годовые величины, которые вычисляются без построения объекта
+  struct YearScalars {
+    ShortDate pasha;
+    int8_t winter_indent;
+    int8_t spring_indent;
+    int8_t apostol_post_length;
+  };
+  static YearScalars year_scalars(const int cycle_year)
+  { //те же значения, что у объекта для года cycle_year (год пасхального цикла), по номерам дней в году:
+    //дата пасхи и дни недели зависят только от номера года в пасхальном цикле
+    const int year = cycle_year + PASCHAL_CYCLE;
+    const bool leap = (year % 4) == 0;
+    const ShortDate pasha = pasha_calc(year);
+    const int p = day_of_year(pasha.first, pasha.second, leap);
+    const int jan1 = static_cast<int>((julian_year_start(year) + 1) % 7);//день недели 1 января (воскресенье=0)
+    auto sunday_from = [jan1](int i){ return i + (7 - (jan1 + i) % 7) % 7; };//первое воскресенье начиная с дня i
+    //зимняя отступка: седмицы от недели по Богоявлении до недели о мытаре и фарисее
+    //и еще одна, если Богоявление (6 янв.) приходится на воскресенье или понедельник
+    const int kdn = (jan1 + 5) % 7;
+    const int zimn = -((p - 70 - sunday_from(6)) / 7) - (kdn == 0 || kdn == 1 ? 1 : 0);
+    //осенняя отступка \ преступка: 17 - номер по пятидесятнице недели по Воздвижении
+    const int osen = 17 - (sunday_from(day_of_year(9, 15, leap)) - (p + 49)) / 7;
+    //петров пост: дни между неделей всех святых и 29 июня
+    const int post = day_of_year(6, 29, leap) - (p + 56) - 1;
+    return { pasha, static_cast<int8_t>(zimn), static_cast<int8_t>(osen), static_cast<int8_t>(post) };
+  }
+  //значения year_scalars для всех лет пасхального цикла (таблица заполняется при первом обращении)
+  static const YearScalars& cycle_year_scalars(const int cycle_year)
+  {
+    static const auto table = []{
+      std::array<YearScalars, PASCHAL_CYCLE> t{};
+      for(int k=0; k<PASCHAL_CYCLE; ++k) t[k] = year_scalars(k);
+      return t;
+    }();
+    return table[cycle_year];
+  }
   int8_t get_winter_indent() const { return winter_indent; }
   int8_t get_spring_indent() const { return spring_indent; }
   int8_t get_date_glas(int8_t month, int8_t day) const;
@@ -1281,116 +1727,38 @@ public:
   ApEvReads get_date_evangelie(int8_t month, int8_t day) const;
   ApEvReads get_resurrect_evangelie(int8_t month, int8_t day) const;
   std::optional<std::vector<uint16_t>> get_date_properties(int8_t month, int8_t day) const;
+  PropertyMask get_date_property_mask(int8_t month, int8_t day) const;
+  bool is_date_of(int8_t month, int8_t day, oxc_const m) const;
   std::optional<ShortDate> get_date_with(oxc_const m) const;
   std::optional<std::vector<ShortDate>> get_alldates_with(oxc_const m) const;
   std::optional<ShortDate> get_date_withanyof(std::span<oxc_const> m) const;
   std::optional<ShortDate> get_date_withallof(std::span<oxc_const> m) const;
   std::optional<std::vector<ShortDate>> get_alldates_withanyof(std::span<oxc_const> m) const;
+  //номера дней признака m в порядке get_alldates_with
+  std::span<const int16_t> days_with(oxc_const m) const;
+  //маска дней, соответствующих любому / всем признакам из m
+  DayMask days_withanyof(std::span<oxc_const> m) const;
+  DayMask days_withallof(std::span<oxc_const> m) const;
+  DayMask days_where(const DatePredicate& predicate) const;
+  //маска дней с first по last включительно (в пределах года)
+  DayMask days_between(ShortDate first, ShortDate last) const;
+  std::optional<ShortDate> get_date_where(const DatePredicate& predicate) const;
+  std::optional<std::vector<ShortDate>> get_alldates_where(const DatePredicate& predicate) const;
+  //дата дня по номеру дня в году (от 0)
+  ShortDate day_date(int i) const { return {data1[i].month, data1[i].day}; }
+  //память (в байтах), занимаемая объектом вместе с его динамическими данными
+  std::size_t memory_usage() const { return sizeof(OrthYear) + marker_days.capacity()*sizeof(int16_t); }
+  //кол-во дней в году
+  int year_length() const { return month_offsets[leap][12]; }
+  //ближайший день из days после (forward) или перед днем (month, day); month == 0 - поиск от начала (конца) года
+  std::optional<ShortDate> adjacent_day(const DayMask& days, int8_t month, int8_t day, bool forward) const;
 };
 
-OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool osen_otstupka_apostol)
-{ //main constructor
-  y = string_to_year(year) ;
-  bool bad_il{};
-  for(auto j: il) if(j<1 || j>33) bad_il = true;
-  if(il.size()!=17 || bad_il)
-    throw std::runtime_error("установлены некорректные параметры отступки/преступки апостольских/евангельских чтений");
-  //таблица - непереходящие даты года
-  static const std::array stable_dates  = {
-    (int)m1d1, 1, 1,
-    (int)m1d2, 1, 2,
-    (int)m1d3, 1, 3,
-    (int)m1d4, 1, 4,
-    (int)m1d5, 1, 5,
-    (int)m1d6, 1, 6,
-    (int)m1d7, 1, 7,
-    (int)m1d8, 1, 8,
-    (int)m1d9, 1, 9,
-    (int)m1d10, 1, 10,
-    (int)m1d11, 1, 11,
-    (int)m1d12, 1, 12,
-    (int)m1d13, 1, 13,
-    (int)m1d14, 1, 14,
-    (int)m3d25, 3, 25,
-    (int)m6d24, 6, 24,
-    (int)m6d25, 6, 25,
-    (int)m6d29, 6, 29,
-    (int)m8d5, 8, 5,
-    (int)m8d6, 8, 6,
-    (int)m8d7, 8, 7,
-    (int)m8d8, 8, 8,
-    (int)m8d9, 8, 9,
-    (int)m8d10, 8, 10,
-    (int)m8d11, 8, 11,
-    (int)m8d12, 8, 12,
-    (int)m8d13, 8, 13,
-    (int)m8d14, 8, 14,
-    (int)m8d15, 8, 15,
-    (int)m8d16, 8, 16,
-    (int)m8d17, 8, 17,
-    (int)m8d18, 8, 18,
-    (int)m8d19, 8, 19,
-    (int)m8d20, 8, 20,
-    (int)m8d21, 8, 21,
-    (int)m8d22, 8, 22,
-    (int)m8d23, 8, 23,
-    (int)m9d7, 9, 7,
-    (int)m9d8, 9, 8,
-    (int)m9d9, 9, 9,
-    (int)m9d10, 9, 10,
-    (int)m9d11, 9, 11,
-    (int)m9d12, 9, 12,
-    (int)m9d13, 9, 13,
-    (int)m9d14, 9, 14,
-    (int)m9d15, 9, 15,
-    (int)m9d16, 9, 16,
-    (int)m9d17, 9, 17,
-    (int)m9d18, 9, 18,
-    (int)m9d19, 9, 19,
-    (int)m9d20, 9, 20,
-    (int)m9d21, 9, 21,
-    (int)m8d29, 8, 29,
-    (int)m10d1, 10, 1,
-    (int)m11d20, 11, 20,
-    (int)m11d21, 11, 21,
-    (int)m11d22, 11, 22,
-    (int)m11d23, 11, 23,
-    (int)m11d24, 11, 24,
-    (int)m11d25, 11, 25,
-    (int)m12d20, 12, 20,
-    (int)m12d21, 12, 21,
-    (int)m12d22, 12, 22,
-    (int)m12d23, 12, 23,
-    (int)m12d24, 12, 24,
-    (int)m12d25, 12, 25,
-    (int)m12d26, 12, 26,
-    (int)m12d27, 12, 27,
-    (int)m12d28, 12, 28,
-    (int)m12d29, 12, 29,
-    (int)m12d30, 12, 30,
-    (int)m12d31, 12, 31
-  };
-  auto make_pair = [](int m, int d){ return ShortDate{m,d}; };
-  //таблица - даты сплошных седмиц
-  static const std::array svyatki_dates = {
-    make_pair(1,1),
-    make_pair(1,2),
-    make_pair(1,3),
-    make_pair(1,4),
-    make_pair(12,25),
-    make_pair(12,26),
-    make_pair(12,27),
-    make_pair(12,28),
-    make_pair(12,29),
-    make_pair(12,30),
-    make_pair(12,31)
-  };
-  //type alias for const tables
-  using TT1 = std::array<std::array<ApEvReads, 7>, 37>;
-  using TT2 = std::map<uint16_t, ApEvReads>;
-  //таблица рядовых чтений на литургии из приложения богосл.евангелия. период от св. троицы до нед. сыропустная
-  //двумерный массив [a][b], где а - календарный номер по пятидесятнице. b - деньнедели.
-  static const TT1 evangelie_table_1 {
+//таблица рядовых чтений на литургии из приложения богосл.евангелия. период от св. троицы до нед. сыропустная
+//двумерный массив [a][b], где а - календарный номер по пятидесятнице. b - деньнедели.
+const OrthYear::TT1& OrthYear::evangelie_table_1()
+{
+  static const TT1 table {
     std::array { ApEvReads{ 0X1B5, "Ин., 27 зач., VII, 37–52; VIII, 12."},  //неделя 0. день св. троицы
             ApEvReads{},
             ApEvReads{},
@@ -1688,12 +2056,14 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
             ApEvReads{ 0X102, "Мф., 16 зач., VI, 1–13."}  //сб
           }
   };
-  auto evangelie_table1_get_chteniya = [](int8_t n50, int8_t dn) {
-    return ApEvReads(evangelie_table_1.at(n50).at(dn));
-  };
-  //таблица рядовых чтений на литургии из приложения богосл.апостола. период от св. троицы до нед. сыропустная
-  //двумерный массив [a][b], где а - календарный номер по пятидесятнице. b - деньнедели.
-  static const TT1 apostol_table_1 {
+  return table;
+}
+
+//таблица рядовых чтений на литургии из приложения богосл.апостола. период от св. троицы до нед. сыропустная
+//двумерный массив [a][b], где а - календарный номер по пятидесятнице. b - деньнедели.
+const OrthYear::TT1& OrthYear::apostol_table_1()
+{
+  static const TT1 table {
     std::array { ApEvReads{ 0X31, "Деян., 3 зач., II, 1–11."},  //неделя 0. день св. троицы
             ApEvReads{},
             ApEvReads{},
@@ -1991,12 +2361,14 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
             ApEvReads{ 0X731, "Рим., 115 зач., XIV, 19–26."}  //сб
           }
   };
-  auto apostol_table1_get_chteniya = [](int8_t n50, int8_t dn) {
-    return ApEvReads(apostol_table_1.at(n50).at(dn));
-  };
-  //таблица рядовых чтений на литургии из приложения богосл.евангелия. период от начала вел.поста до Троицкая суб.вкл.
-  //асс.массив, где first - константа-признак даты (блок 1 - переходящие дни года)
-  static const TT2 evangelie_table_2 {
+  return table;
+}
+
+//таблица рядовых чтений на литургии из приложения богосл.евангелия. период от начала вел.поста до Троицкая суб.вкл.
+//асс.массив, где first - константа-признак даты (блок 1 - переходящие дни года)
+const OrthYear::TT2& OrthYear::evangelie_table_2()
+{
+  static const TT2 table {
     {1,    { 0X15, "Ин., 1 зач., I, 1–17." } },//пасха
     {2,    { 0X25, "Ин., 2 зач., I, 18–28." } },
     {3,    { 0X714, "Лк., 113 зач., XXIV, 12–35."  } },
@@ -2064,23 +2436,14 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
     {132,  { 0X6B2, "Мф., 107 зач., XXVI, 1–20. Ин., 44 зач., XIII, 3–17. Мф., 108 зач.(от полу́), XXVI, 21–39. Лк., 109 зач., XXII, 43–45. Мф., 108 зач., XXVI, 40 – XXVII, 2." } },//великий Четверток
     {134,  { 0X732, "Мф., 115 зач., XXVIII, 1–20." } } //великую Субботу
   };
-  auto evangelie_table2_get_chteniya = [](const std::set<uint16_t>& markers)->ApEvReads {
-    if(markers.empty()) return ApEvReads();
-    std::vector<uint16_t> t_(evangelie_table_2.size());
-    std::transform(evangelie_table_2.cbegin(), evangelie_table_2.cend(),
-                    t_.begin(),
-                    [](const auto& e){ return e.first; });
-    auto fr1 = std::find_first_of(markers.begin(), markers.end(), t_.begin(), t_.end());
-    if(fr1==markers.end()) return ApEvReads();
-    if(auto fr2 = evangelie_table_2.find(*fr1); fr2 != evangelie_table_2.end()) {
-      return ApEvReads(fr2->second);
-    } else {
-      return ApEvReads();
-    }
-  };
-  //таблица рядовых чтений на литургии из приложения богосл.апостола. период от начала вел.поста до Троицкая суб.вкл.
-  //асс.массив, где first - константа-признак даты (блок 1 - переходящие дни года)
-  static const TT2 apostol_table_2 {
+  return table;
+}
+
+//таблица рядовых чтений на литургии из приложения богосл.апостола. период от начала вел.поста до Троицкая суб.вкл.
+//асс.массив, где first - константа-признак даты (блок 1 - переходящие дни года)
+const OrthYear::TT2& OrthYear::apostol_table_2()
+{
+  static const TT2 table {
     {1,    { 0X11, "Деян., 1 зач., I, 1–8." } },   //пасха
     {2,    { 0X21, "Деян., 2 зач., I, 12–17, 21–26." } },
     {3,    { 0X41, "Деян., 4 зач., II, 14–21." } },
@@ -2146,15 +2509,59 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
     {134,  { 0X5B1, "Рим., 91 зач., VI, 3–11." } }//великую Субботу
 
   };
+  return table;
+}
+
+OrthYear::OrthYear(const YearTraits& traits, std::span<const uint8_t> il, bool osen_otstupka_apostol)
+{ //main constructor
+  bool bad_il{};
+  for(auto j: il) if(j<1 || j>33) bad_il = true;
+  if(il.size()!=17 || bad_il)
+    throw std::runtime_error("установлены некорректные параметры отступки/преступки апостольских/евангельских чтений");
+  auto make_pair = [](int m, int d){ return ShortDate{m,d}; };
+  //таблица - даты сплошных седмиц
+  static const std::array svyatki_dates = {
+    make_pair(1,1),
+    make_pair(1,2),
+    make_pair(1,3),
+    make_pair(1,4),
+    make_pair(12,25),
+    make_pair(12,26),
+    make_pair(12,27),
+    make_pair(12,28),
+    make_pair(12,29),
+    make_pair(12,30),
+    make_pair(12,31)
+  };
+  auto evangelie_table1_get_chteniya = [](int8_t n50, int8_t dn) {
+    return ApEvReads(evangelie_table_1().at(n50).at(dn));
+  };
+  auto apostol_table1_get_chteniya = [](int8_t n50, int8_t dn) {
+    return ApEvReads(apostol_table_1().at(n50).at(dn));
+  };
+  auto evangelie_table2_get_chteniya = [](const std::set<uint16_t>& markers)->ApEvReads {
+    if(markers.empty()) return ApEvReads();
+    std::vector<uint16_t> t_(evangelie_table_2().size());
+    std::transform(evangelie_table_2().cbegin(), evangelie_table_2().cend(),
+                    t_.begin(),
+                    [](const auto& e){ return e.first; });
+    auto fr1 = std::find_first_of(markers.begin(), markers.end(), t_.begin(), t_.end());
+    if(fr1==markers.end()) return ApEvReads();
+    if(auto fr2 = evangelie_table_2().find(*fr1); fr2 != evangelie_table_2().end()) {
+      return ApEvReads(fr2->second);
+    } else {
+      return ApEvReads();
+    }
+  };
   auto apostol_table2_get_chteniya = [](const std::set<uint16_t>& markers)->ApEvReads {
     if(markers.empty()) return ApEvReads();
-    std::vector<uint16_t> t_(apostol_table_2.size());
-    std::transform(apostol_table_2.cbegin(), apostol_table_2.cend(),
+    std::vector<uint16_t> t_(apostol_table_2().size());
+    std::transform(apostol_table_2().cbegin(), apostol_table_2().cend(),
                     t_.begin(),
                     [](const auto& e){ return e.first; });
     auto fr1 = std::find_first_of(markers.begin(), markers.end(), t_.begin(), t_.end());
     if(fr1==markers.end()) return ApEvReads();
-    if(auto fr2 = apostol_table_2.find(*fr1); fr2 != apostol_table_2.end()) {
+    if(auto fr2 = apostol_table_2().find(*fr1); fr2 != apostol_table_2().end()) {
       return ApEvReads(fr2->second);
     } else {
       return ApEvReads();
@@ -2198,11 +2605,10 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
   };
   std::map<ShortDate, DayData> days;
   std::multimap<uint16_t, ShortDate> markers;
-  const auto pasha_date = pasha_calc(y);
-  const auto pasha_date_pred = pasha_calc(y-1);
-  auto is_visokos = [](const big_int& y) { return (y%4)==0; };
-  const bool b = is_visokos(y);
-  const bool b1 = is_visokos(y-1);
+  const auto pasha_date = traits.pasha;
+  const auto pasha_date_pred = traits.pasha_pred;
+  const bool b = traits.leap;
+  const bool b1 = traits.leap_pred;
   ShortDate nachalo_posta, t1, t2, t3;
   ShortDate dd {pasha_date};
   int i = 0, j = 0, glas = 8;
@@ -2280,12 +2686,10 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
   //функц.создание карты дней недели указанного года в формате:
   //key - дата; key.first - месяц; key.second - день
   //value - деньнедели; 0-вс, 1-пн, 2-вт, 3-ср, 4-чт, 5-пт, 6-сб.
-  auto create_days_map_ = [&increment_date_, &decrement_date_, &is_visokos, this]
-                          (const big_int& y) -> std::optional<std::map<ShortDate, int8_t>>
+  //pasha_date - дата пасхи года; b - признак високосного года
+  auto create_days_map_ = [&increment_date_, &decrement_date_]
+                          (const ShortDate pasha_date, const bool b) -> std::optional<std::map<ShortDate, int8_t>>
   {
-    if(y<1) return std::nullopt;
-    const bool b = is_visokos(y);
-    const auto pasha_date = pasha_calc(y) ;
     ShortDate data1, data2;
     std::map<ShortDate, int8_t> result;
     int i = 0;
@@ -2324,7 +2728,6 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
       assert((void("markers container insertion failed"),
               std::none_of(markers.begin(), markers.end(), [d,m](const auto& e){ return m==e.first && d==e.second; })));
       markers.insert({m, d});
-      assert(fr->second.day_markers.size() <= M_COUNT);
     } else {
       assert((void("element not found"), false));
     }
@@ -2347,7 +2750,6 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
         assert((void("markers container insertion failed"),
                 std::none_of(markers.begin(), markers.end(), [d,i](const auto& e){ return i==e.first && d==e.second; })));
         markers.insert({i, d});
-        assert(fr->second.day_markers.size() <= M_COUNT);
       }
     } else {
       assert((void("element not found"), false));
@@ -2409,17 +2811,17 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
     else return -1;
   };
   //создание карт дней недели всего года
-  if(auto x = create_days_map_(y)) {
+  if(auto x = create_days_map_(pasha_date, b)) {
     std::transform(x->cbegin(), x->cend(), std::inserter(days, days.end()), [](const auto& e){
       return std::make_pair(e.first, DayData{e.second});
     });
   }
-  if(auto x = create_days_map_(y-1)) {
+  if(auto x = create_days_map_(pasha_date_pred, b1)) {
     dn_prev = std::move(*x);
   }
   //расчет дат непереходящих праздников
-  for(auto it = stable_dates.begin(); it != stable_dates.end(); it = std::next(it,3)) {
-    add_marker_for_date_(ShortDate(*std::next(it), *std::next(it,2)), *it);
+  for(size_t i=0; i<fixed_dates_table.size(); ++i) {
+    add_marker_for_date_(fixed_dates_table[i], oxc::m1d1 + i);
   }
   for(const auto& x: svyatki_dates) add_marker_for_date_(x, full7_svyatki);
   for( auto x=make_pair(11,15), y=make_pair(12,25); x<y; x=increment_date_(x,1,b) ) {
@@ -3761,7 +4163,7 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
     else       { break; }
   }
   //save data to object
-  data1.reserve(days.size());
+  leap = b;
   std::for_each(days.begin(), days.end(), [this](const auto& e){
     Data1 d;
     d.dn = e.second.dn;
@@ -3771,25 +4173,28 @@ OrthYear::OrthYear(const std::string& year, std::span<const uint8_t> il, bool os
     d.month = e.first.first;
     d.apostol = e.second.apostol;
     d.evangelie = e.second.evangelie;
-    std::copy(e.second.day_markers.begin(), e.second.day_markers.end(), d.day_markers.begin());
-    data1.push_back(std::move(d));
-  });
-  data2.reserve(markers.size());
-  std::for_each(markers.begin(), markers.end(), [this](const auto& e){
-    Data2 d;
-    d.marker = e.first;
-    d.day = e.second.second;
-    d.month = e.second.first;
-    data2.push_back(std::move(d));
+    const int i = day_of_year(d.month, d.day, leap);
+    assert((void("day of year out of range"), i >= 0));
+    for(auto m: e.second.day_markers) {
+      const int id = property_id(m);
+      assert((void("unknown day marker"), id >= 0));
+      d.day_markers.set(id);
+      property_days[id].set(i);
+    }
+    data1[i] = std::move(d);
   });
-  data1.shrink_to_fit();
-  data2.shrink_to_fit();
+  //порядок дней внутри признака - порядок вставки в markers
+  for(const auto& [m, d]: markers) ++marker_offsets[property_id(m) + 1];
+  for(size_t id=0; id<PROPERTIES_COUNT; ++id) marker_offsets[id+1] += marker_offsets[id];
+  marker_days.resize(markers.size());
+  auto next = marker_offsets;
+  for(const auto& [m, d]: markers) marker_days[next[property_id(m)]++] = day_of_year(d.first, d.second, leap);
 }//end OrthYear ctor
 
 int8_t OrthYear::get_date_glas(int8_t month, int8_t day) const
 {
   if(auto fr = find_in_data1(month, day); fr) {
-    return fr.value()->glas;
+    return fr->glas;
   } else {
     return -1;
   }
@@ -3798,7 +4203,7 @@ int8_t OrthYear::get_date_glas(int8_t month, int8_t day) const
 int8_t OrthYear::get_date_n50(int8_t month, int8_t day) const
 {
   if(auto fr = find_in_data1(month, day); fr) {
-    return fr.value()->n50;
+    return fr->n50;
   } else {
     return -1;
   }
@@ -3807,7 +4212,7 @@ int8_t OrthYear::get_date_n50(int8_t month, int8_t day) const
 int8_t OrthYear::get_date_dn(int8_t month, int8_t day) const
 {
   if(auto fr = find_in_data1(month, day); fr) {
-    return fr.value()->dn;
+    return fr->dn;
   } else {
     return -1;
   }
@@ -3816,7 +4221,7 @@ int8_t OrthYear::get_date_dn(int8_t month, int8_t day) const
 ApEvReads OrthYear::get_date_apostol(int8_t month, int8_t day) const
 {
   if(auto fr = find_in_data1(month, day); fr) {
-    return fr.value()->apostol;
+    return fr->apostol;
   } else {
     return {};
   }
@@ -3825,16 +4230,15 @@ ApEvReads OrthYear::get_date_apostol(int8_t month, int8_t day) const
 ApEvReads OrthYear::get_date_evangelie(int8_t month, int8_t day) const
 {
   if(auto fr = find_in_data1(month, day); fr) {
-    return fr.value()->evangelie;
+    return fr->evangelie;
   } else {
     return {};
   }
 }
 
-ApEvReads OrthYear::get_resurrect_evangelie(int8_t month, int8_t day) const
+template<typename HasMarker>
+  ApEvReads OrthYear::resurrect_evangelie(int8_t n50, HasMarker has_marker)
 {
-  auto dn = get_date_dn(month, day);
-  if(dn != 0) return {};
   //таблица 11-и воскресныx утрених евангелий
   static const std::array resurrect_evangelie_table = {
     ApEvReads{ 0X742,  "Мф., 116 зач., XXVIII, 16–20." },
@@ -3878,13 +4282,7 @@ ApEvReads OrthYear::get_resurrect_evangelie(int8_t month, int8_t day) const
     m11d21,
     m12d25
   };
-  auto w = unique_evangelie_table.end();
-  if( auto date_properties = get_date_properties(month, day); date_properties ) {
-    w = std::find_first_of(unique_evangelie_table.begin(),
-                              unique_evangelie_table.end(),
-                              date_properties->begin(),
-                              date_properties->end());
-  }
+  auto w = std::find_if(unique_evangelie_table.begin(), unique_evangelie_table.end(), has_marker);
   if( w != unique_evangelie_table.end() ) {
     switch(*w) {
       case ned2_popashe:  { return resurrect_evangelie_table[0]; }
@@ -3907,7 +4305,6 @@ ApEvReads OrthYear::get_resurrect_evangelie(int8_t month, int8_t day) const
       default:            { return {}; }
     };
   } else {
-    auto n50 = get_date_n50(month, day);
     if(n50>0 && n50<12) {
       return resurrect_evangelie_table[n50-1] ;
     } else if(n50>11) {
@@ -3919,13 +4316,26 @@ ApEvReads OrthYear::get_resurrect_evangelie(int8_t month, int8_t day) const
   return {};
 }
 
+ApEvReads OrthYear::get_resurrect_evangelie(int8_t month, int8_t day) const
+{
+  auto dn = get_date_dn(month, day);
+  if(dn != 0) return {};
+  const auto fr = find_in_data1(month, day);
+  return resurrect_evangelie(get_date_n50(month, day),
+                              [fr](auto x){ return fr && fr->day_markers.test(property_id(x)); });
+}
+
+OrthYear::PropertyMask OrthYear::get_date_property_mask(int8_t month, int8_t day) const
+{
+  if(auto fr = find_in_data1(month, day); fr) return fr->day_markers;
+  return {};
+}
+
 std::optional<std::vector<uint16_t>> OrthYear::get_date_properties(int8_t month, int8_t day) const
 {
   if(auto fr = find_in_data1(month, day); fr) {
     std::vector<uint16_t> res ;
-    std::copy_if(fr.value()->day_markers.begin(), fr.value()->day_markers.end(),
-                  std::back_inserter(res),
-                  [](auto x){ return x>0; });
+    fr->day_markers.for_each([&res](auto i){ res.push_back(properties_table[i].first); });
     if(res.empty()) return std::nullopt;
     return res;
   } else {
@@ -3933,99 +4343,653 @@ std::optional<std::vector<uint16_t>> OrthYear::get_date_properties(int8_t month,
   }
 }
 
+bool OrthYear::is_date_of(int8_t month, int8_t day, oxc_const m) const
+{
+  const int id = property_id(m);
+  if(id<0) return false;
+  const int i = day_of_year(month, day, leap);
+  return i>=0 && property_days[id].test(i);
+}
+
+std::span<const int16_t> OrthYear::days_with(oxc_const m) const
+{
+  const int id = property_id(m);
+  if(id<0) return {};
+  return std::span(marker_days).subspan(marker_offsets[id], marker_offsets[id+1] - marker_offsets[id]);
+}
+
 std::optional<ShortDate> OrthYear::get_date_with(uint16_t m) const
 {
-  if(m<1) return std::nullopt;
-  auto fr = std::lower_bound(data2.begin(), data2.end(), m);
-  if(fr==data2.end()) return std::nullopt;
-  if( !(*fr==m) ) return std::nullopt;
-  return ShortDate{fr->month, fr->day};
+  const auto days = days_with(m);
+  if(days.empty()) return std::nullopt;
+  return day_date(days.front());
 }
 
 std::optional<std::vector<ShortDate>> OrthYear::get_alldates_with(uint16_t m) const
 {
-  if(m<1) return std::nullopt;
-  auto [begin, end] = std::equal_range(data2.begin(), data2.end(), m);
-  if(begin==data2.end()) return std::nullopt;
+  const auto days = days_with(m);
+  if(days.empty()) return std::nullopt;
   std::vector<ShortDate> res ;
-  std::transform(begin, end, std::back_inserter(res),
-        [](const auto& e){ return ShortDate{e.month, e.day}; });
-  if(res.empty()) return std::nullopt;
+  res.reserve(days.size());
+  for(auto i: days) res.push_back(day_date(i));
   return res;
 }
 
-std::optional<ShortDate> OrthYear::get_date_withanyof(std::span<oxc_const> m) const
+OrthYear::DayMask OrthYear::days_withanyof(std::span<oxc_const> m) const
 {
-  if(m.empty()) return std::nullopt;
-  for(auto i: m) { if(auto x = get_date_with(i); x) return *x; }
+  DayMask days;
+  for(auto x: m) {
+    if(const int id = property_id(x); id>=0) days |= property_days[id];
+  }
+  return days;
+}
+
+OrthYear::DayMask OrthYear::days_withallof(std::span<oxc_const> m) const
+{
+  DayMask days;
+  if(m.empty()) return days;
+  days.words.fill(~uint64_t{});
+  for(auto x: m) {
+    const int id = property_id(x);
+    if(id<0) return {};
+    days &= property_days[id];
+  }
+  return days;
+}
+
+std::optional<ShortDate> OrthYear::get_date_withanyof(std::span<oxc_const> m) const
+{ //первая дата первого из признаков, у которого она есть
+  for(auto x: m) {
+    if(const auto days = days_with(x); !days.empty()) return day_date(days.front());
+  }
   return std::nullopt;
 }
 
 std::optional<ShortDate> OrthYear::get_date_withallof(std::span<oxc_const> m) const
-{
+{ //первая (в порядке get_alldates_with) дата первого признака, у которой есть все признаки
   if(m.empty()) return std::nullopt;
-  auto semires = get_alldates_with(m.front());
-  if(!semires) return std::nullopt;
-  for(auto [month, day] : *semires) {
-    const bool b = std::all_of(m.begin(), m.end(), [this, month, day](auto x){
-      auto fr = find_in_data1(month, day);
-      return std::any_of(fr.value()->day_markers.begin(), fr.value()->day_markers.end(),
-                          [x](auto y){ return y==x; });
-    });
-    if(b) return ShortDate{month, day};
+  const auto all = days_withallof(m);
+  for(auto i: days_with(m.front())) {
+    if(all.test(i)) return day_date(i);
   }
   return std::nullopt;
 }
 
 std::optional<std::vector<ShortDate>> OrthYear::get_alldates_withanyof(std::span<oxc_const> m) const
-{
-  if(m.empty()) return std::nullopt;
+{ //даты признаков в порядке их перечисления в m; дата, общая для нескольких признаков, повторяется
   std::vector<ShortDate> result;
-  for(auto i: m) {
-    if(auto x=get_alldates_with(i); x)
-      std::copy(x->begin(), x->end(), std::back_inserter(result));
+  for(auto x: m) {
+    for(auto i: days_with(x)) result.push_back(day_date(i));
   }
   if(result.empty()) return std::nullopt;
   else return result;
 }
 
-/*----------------------------------------------------*/
-/*          class OrthodoxCalendar::impl              */
-/*----------------------------------------------------*/
+OrthYear::DayMask OrthYear::days_where(const DatePredicate& predicate) const
+{
+  using Code = DatePredicate::plan::Code;
+  const auto& plan = *predicate.p;
+  std::vector<DayMask> stack;
+  stack.reserve(plan.depth);
+  for(const auto& op: plan.ops) {
+    switch(op.code) {
+      case Code::property: stack.push_back(op.arg >= 0 ? property_days[op.arg] : DayMask{}); break;
+      case Code::weekday:  stack.push_back(days_of(&Data1::dn, op.arg));                     break;
+      case Code::glas:     stack.push_back(days_of(&Data1::glas, op.arg));                   break;
+      case Code::n50:      stack.push_back(days_of(&Data1::n50, op.arg));                    break;
+      case Code::op_and: {
+        const auto x = stack.back();
+        stack.pop_back();
+        stack.back() &= x;
+        break;
+      }
+      case Code::op_or: {
+        const auto x = stack.back();
+        stack.pop_back();
+        stack.back() |= x;
+        break;
+      }
+      case Code::op_not: {
+        auto x = ~stack.back();
+        x &= year_days();
+        stack.back() = x;
+        break;
+      }
+    }
+  }
+  assert((void("unbalanced predicate plan"), stack.size() == 1));
+  return stack.back();
+}
 
-class OrthodoxCalendar::impl {
+OrthYear::DayMask OrthYear::days_between(ShortDate first, ShortDate last) const
+{
+  DayMask days;
+  const int i = day_of_year(first.first, first.second, leap);
+  const int j = day_of_year(last.first, last.second, leap);
+  assert((void("day of year out of range"), i >= 0 && j >= 0));
+  for(int k=i; k<=j; ++k) days.set(k);
+  return days;
+}
 
-  //настройка номеров добавочных седмиц зимней отступкu литургийных чтений
-  std::array<uint8_t,5> zimn_otstupka_n5; //при отступке в 5 седмиц.
-  std::array<uint8_t,4> zimn_otstupka_n4; //при отступке в 4 седмиц.
-  std::array<uint8_t,3> zimn_otstupka_n3; //при отступке в 3 седмиц.
-  std::array<uint8_t,2> zimn_otstupka_n2; //при отступке в 2 седмиц.
-  std::array<uint8_t,1> zimn_otstupka_n1; //при отступке в 1 седмиц.
-  //настройка номеров добавочных седмиц осенней отступкu литургийных чтений
-  std::array<uint8_t,2> osen_otstupka;
-  bool osen_otstupka_apostol; //при вычислении осенней отступкu учитывать ли апостол
-  mutable std::unordered_map<std::string, oxc::OrthYear> orthyear_cache;
+std::optional<ShortDate> OrthYear::adjacent_day(const DayMask& days, int8_t month, int8_t day, bool forward) const
+{
+  int i;
+  if(month == 0) i = forward ? -1 : DayMask::WORDS*64;
+  else if(i = day_of_year(month, day, leap); i < 0) return std::nullopt;
+  i = forward ? days.find_next(i) : days.find_prev(i);
+  if(i<0) return std::nullopt;
+  return day_date(i);
+}
 
-  OrthYear& get_orthyear_obj(const std::string& year) const;
-  template<typename Container>
-    bool set_indent_week_numbers_option(Container& container, std::initializer_list<uint8_t> il);
-  template<typename MethodPtr>
-    auto get_date_option(const Date& date, MethodPtr mptr) const;
-  template<typename TProperty, typename OrthYearMethod, typename SelfPeriodMethod>
-    Date get_date__(const Year& year, TProperty property, const CalendarFormat infmt, OrthYearMethod orthyear_method,
-          SelfPeriodMethod period_method) const;
-  template<typename TProperty, typename OrthYearMethod>
-    Date get_date_inperiod__(const Date& d1, const Date& d2, TProperty property, OrthYearMethod orthyear_method) const;
-  template<typename TProperty, typename OrthYearMethod, typename SelfPeriodMethod>
-    std::vector<Date> get_alldates__(const Year& year, TProperty property, const CalendarFormat infmt,
-          OrthYearMethod orthyear_method, SelfPeriodMethod period_method) const;
-  template<typename TProperty, typename OrthYearMethod>
-    std::vector<Date> get_alldates_inperiod__(const Date& d1, const Date& d2, TProperty property,
-          OrthYearMethod orthyear_method) const;
+std::optional<ShortDate> OrthYear::get_date_where(const DatePredicate& predicate) const
+{
+  const int i = days_where(predicate).find_first();
+  if(i<0) return std::nullopt;
+  return day_date(i);
+}
 
-public:
+std::optional<std::vector<ShortDate>> OrthYear::get_alldates_where(const DatePredicate& predicate) const
+{
+  std::vector<ShortDate> result;
+  days_where(predicate).for_each([this, &result](auto i){ result.push_back(day_date(i)); });
+  if(result.empty()) return std::nullopt;
+  else return result;
+}
+
+/*----------------------------------------------*/
+/*              class DayEvaluator              */
+/*----------------------------------------------*/
+
+//глас, номер по пятидесятнице и рядовые чтения отдельного дня года без построения объекта OrthYear.
+//все величины выводятся из смещения дня от пасхи текущего и предыдущего года и настроек отступки;
+//результаты совпадают с соответствующими методами OrthYear. дни задаются номером дня в году (от 0)
+class DayEvaluator {
+  std::array<uint8_t,17> il; //номера добавочных седмиц в порядке OrthodoxCalendar::get_options()
+  bool osen_otstupka_apostol;
+  bool leap;
+  int p;      //номер дня пасхи
+  int p_pred; //номер дня пасхи пред. года, отсчитанный от начала текущего года (отрицательный)
+  int zimn;   //зимняя отступка
+  int osen;   //осенняя отступка \ преступка
+  int sn;     //тоже для пред. года
+  int ddd;    //начало нового ряда чтений при зимней отступке
+  int vozdv;  //неделя по Воздвижении
+
+  int dn(int t) const { return ((t - p) % 7 + 7) % 7; }
+  //первое воскресенье начиная с дня t
+  int sunday_from(int t) const { return t + (7 - dn(t)) % 7; }
+  //день признака m или -1, если признак не вычисляется (используется для признаков воскресных евангелий)
+  int marker_day(oxc_const m) const;
+  ApEvReads readings(int t, const OrthYear::TT1& table1, const OrthYear::TT2& table2, bool apostol) const;
+
+public:
+
+  DayEvaluator(const int cycle_year, const std::array<uint8_t,17>& il, bool osen_otstupka_apostol);
+  //номер дня в году (от 0) или -1 для некорректной даты
+  int day_index(int8_t month, int8_t day) const { return OrthYear::day_of_year(month, day, leap); }
+  int8_t glas(int t) const;
+  int8_t n50(int t) const;
+  ApEvReads apostol(int t) const { return readings(t, OrthYear::apostol_table_1(), OrthYear::apostol_table_2(), true); }
+  ApEvReads evangelie(int t) const { return readings(t, OrthYear::evangelie_table_1(), OrthYear::evangelie_table_2(), false); }
+  ApEvReads resurrect_evangelie(int t) const;
+};
+
+DayEvaluator::DayEvaluator(const int cycle_year, const std::array<uint8_t,17>& il, bool osen_otstupka_apostol)
+  : il(il), osen_otstupka_apostol(osen_otstupka_apostol)
+{ //те же параметры, что у объекта OrthYear для года cycle_year + PASCHAL_CYCLE
+  const auto traits = OrthYear::year_traits(cycle_year + PASCHAL_CYCLE);
+  leap = traits.leap;
+  p = OrthYear::day_of_year(traits.pasha.first, traits.pasha.second, leap);
+  p_pred = OrthYear::day_of_year(traits.pasha_pred.first, traits.pasha_pred.second, traits.leap_pred)
+            - OrthYear::month_offsets[traits.leap_pred][12];
+  const auto& x = OrthYear::cycle_year_scalars(cycle_year);
+  zimn = x.winter_indent;
+  osen = x.spring_indent;
+  sn = OrthYear::cycle_year_scalars((cycle_year + PASCHAL_CYCLE - 1) % PASCHAL_CYCLE).spring_indent;
+  //новый ряд чтений начинается 7 янв., если Богоявление в воскресенье или понедельник, иначе после недели по Богоявлении
+  const int kdn = dn(5);
+  ddd = (kdn == 0 || kdn == 1) ? 6 : sunday_from(6) + 1;
+  vozdv = sunday_from(OrthYear::day_of_year(9, 15, leap));
+}
+
+int8_t DayEvaluator::glas(int t) const
+{ //гласы сменяются по воскресеньям начиная с 8-го в седмицу после недели всех святых (текущего или пред. года)
+  if(t >= p - 8 && t <= p + 56) return -1;
+  const int x = t > p ? t - p : t - p_pred;
+  return static_cast<int8_t>(((x - 56) / 7 + 7) % 8 + 1);
+}
+
+int8_t DayEvaluator::n50(int t) const
+{ //номер увеличивается по понедельникам после пятидесятницы (текущего или пред. года)
+  if(t < p - 48) return static_cast<int8_t>((t - (p_pred + 49) + 6) / 7);
+  if(t < p + 49) return -1;
+  return static_cast<int8_t>((t - (p + 49) + 6) / 7);
+}
+
+ApEvReads DayEvaluator::readings(int t, const OrthYear::TT1& table1, const OrthYear::TT2& table2, bool apostol) const
+{ //порядок периодов и выбор строк таблиц - как в конструкторе OrthYear
+  const int j = dn(t);
+  auto row = [&table1, j](int n){ return ApEvReads(table1.at(n).at(j)); };
+  const int dd = p - 70;//неделя о мытаре и фарисее
+  //период от начала года до субб.перед нед.омытариифарисеи вкл. без отступки
+  //+период от начала года до начала нового ряда чтений при наличии отступки
+  if(t < (zimn != 0 ? ddd : dd)) return row(apostol ? n50(t) : n50(t) + sn);
+  //период нового ряда чтений при наличии отступки: добавочные недели и седмицы расходуются по одной
+  //с каждым воскресеньем начиная с ddd
+  if(t < dd) {
+    static constexpr std::array<std::array<uint8_t,4>,5> weeks = {{
+      {}, {32}, {32, 31}, {32, 31, 30}, {32, 17, 31, 30}
+    }};
+    const int a = -zimn;
+    if(a > 5) return {};
+    const int first = sunday_from(ddd);
+    const int s = t < first ? 0 : (t - first) / 7 + 1;//кол-во воскресений от ddd до t вкл.
+    if(j == 0) return s <= a - 1 ? row(weeks[a-1][a-1-s]) : ApEvReads{};
+    return s < a ? row(il[a*(a-1)/2 + s]) : ApEvReads{};
+  }
+  //период от нед. о мытари и фарисеи до прощ. воскр. вкл.
+  if(t <= dd + 21) return row(33 + (t - dd + 6) / 7);
+  //период от начала в.поста до троицкой род.субб вкл.: по признаку дня от пасхи
+  const int t3 = p + 49;//пятидесятница
+  if(t < t3) {
+    const int o = t - p;
+    const uint16_t m = o >= 0 ? pasha + o : vel_post_d1n1 + 48 + o;
+    if(auto fr = table2.find(m); fr != table2.end()) return ApEvReads(fr->second);
+    return {};
+  }
+  //период от пятидесятницы до конца года
+  if(apostol && !osen_otstupka_apostol) return row(n50(t));
+  if(t <= vozdv - 14 || (t <= vozdv && osen >= 0)) return row(n50(t));
+  if(t <= vozdv - 7) return osen == -2 ? row(il[15]) : row(n50(t));
+  if(t <= vozdv) return row(il[16]);
+  return row(n50(t) + osen);
+}
+
+int DayEvaluator::marker_day(oxc_const m) const
+{
+  if(m == sretenie) {
+    const int d = OrthYear::day_of_year(2, 2, leap);
+    return d >= p - 48 ? p - 49 : d;
+  }
+  if(auto x = fixed_date_of(m)) return OrthYear::day_of_year(x->first, x->second, leap);
+  if(m >= pasha && m <= ned1_po50) return p + m - pasha;
+  if(m >= vel_post_d1n1 && m <= vel_post_d0n7) return p - 48 + m - vel_post_d1n1;
+  return -1;
+}
+
+ApEvReads DayEvaluator::resurrect_evangelie(int t) const
+{
+  if(dn(t) != 0) return {};
+  return OrthYear::resurrect_evangelie(n50(t), [this, t](auto m){ return marker_day(m) == t; });
+}
+
+/*----------------------------------------------------*/
+/*              class OrthYearCache                   */
+/*----------------------------------------------------*/
+
+//упакованные настройки отступки литургийных чтений: номера седмиц в порядке get_options() по 6 бит,
+//затем флаг учета апостола при осенней отступке
+struct OptionsFingerprint {
+  std::array<uint64_t, 2> words{};
+  bool operator==(const OptionsFingerprint&) const = default;
+};
+
+struct OrthYearKey {
+  int cycle_year;
+  OptionsFingerprint options;
+  bool operator==(const OrthYearKey&) const = default;
+};
+
+struct OrthYearKeyHash {
+  std::size_t operator()(const OrthYearKey& k) const noexcept
+  {
+    uint64_t h = static_cast<uint64_t>(k.cycle_year);
+    for(auto w: k.options.words) {
+      h ^= w + 0x9E3779B97F4A7C15u + (h << 6) + (h >> 2);
+    }
+    return static_cast<std::size_t>(h);
+  }
+};
+
+//потокобезопасный кэш объектов OrthYear. кэш разбит на сегменты со своими блокировками:
+//поиск выполняется под разделяемой блокировкой сегмента, вставка и вытеснение - под исключительной.
+//при превышении лимита памяти вытесняются записи, к которым дольше всего не было обращений (LRU),
+//кроме записей закрепленных лет цикла. объекты выдаются через shared_ptr, поэтому вытеснение
+//не затрагивает объекты, которые в это время используются другими потоками
+class OrthYearCache {
+
+  static constexpr std::size_t SHARDS = 16;
+
+  struct Entry {
+    std::shared_ptr<const OrthYear> obj;
+    mutable std::atomic<uint64_t> last_use;//значение epoch при последнем обращении
+    std::size_t size;//память, занимаемая записью (см. entry_size)
+    Entry(std::shared_ptr<const OrthYear> o, uint64_t t);
+  };
+  using Map = std::unordered_map<OrthYearKey, Entry, OrthYearKeyHash>;
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    Map entries;
+  };
+
+  //память, занимаемая записью: объект с его динамическими данными, блок управления shared_ptr и узел хэш-таблицы
+  static std::size_t entry_size(const OrthYear& obj)
+  {
+    return obj.memory_usage() + 2*sizeof(void*) + sizeof(Map::value_type) + 2*sizeof(void*);
+  }
+
+  std::array<Shard, SHARDS> shards;
+  std::array<std::atomic<bool>, PASCHAL_CYCLE> pinned{};//индекс - номер года в цикле
+  std::atomic<std::size_t> limit;
+  std::atomic<std::size_t> used{};
+  std::atomic<uint64_t> epoch{};//увеличивается при каждой вставке
+
+  void touch(const Entry& e) const
+  { //запись в last_use только при смене epoch, чтобы частые обращения не конкурировали за кэш-линию
+    const auto t = epoch.load(std::memory_order_relaxed);
+    if(e.last_use.load(std::memory_order_relaxed) != t) e.last_use.store(t, std::memory_order_relaxed);
+  }
+  void evict(std::size_t first_shard)
+  { //сегменты блокируются по одному, начиная с first_shard
+    for(std::size_t i=0; i<SHARDS && used > limit; ++i) {
+      auto& s = shards[(first_shard + i) % SHARDS];
+      std::unique_lock lock(s.mutex);
+      while(used > limit) {
+        auto victim = s.entries.end();
+        for(auto it = s.entries.begin(); it != s.entries.end(); ++it) {
+          if(pinned[it->first.cycle_year]) continue;
+          if(victim == s.entries.end() || it->second.last_use < victim->second.last_use) victim = it;
+        }
+        if(victim == s.entries.end()) break;
+        used -= victim->second.size;
+        s.entries.erase(victim);
+      }
+    }
+  }
+  static std::size_t shard_of(const OrthYearKey& key) { return OrthYearKeyHash{}(key) % SHARDS; }
+
+public:
+
+  static constexpr std::size_t DEFAULT_LIMIT = std::size_t{64} << 20;
+
+  OrthYearCache() : limit(DEFAULT_LIMIT) {}
+  //копия разделяет с оригиналом неизменяемые объекты OrthYear
+  OrthYearCache(const OrthYearCache& other) : limit(other.limit.load()), epoch(other.epoch.load())
+  {
+    for(std::size_t i=0; i<PASCHAL_CYCLE; ++i) pinned[i] = other.pinned[i].load();
+    for(std::size_t i=0; i<SHARDS; ++i) {
+      std::shared_lock lock(other.shards[i].mutex);
+      for(const auto& [key, e]: other.shards[i].entries) {
+        shards[i].entries.try_emplace(key, e.obj, e.last_use.load(std::memory_order_relaxed));
+        used += e.size;
+      }
+    }
+  }
+
+  //возвращает объект по ключу; при отсутствии создает его вызовом make()
+  template<typename Factory>
+    std::shared_ptr<const OrthYear> get(const OrthYearKey& key, Factory make)
+  {
+    const auto i = shard_of(key);
+    auto& s = shards[i];
+    {
+      std::shared_lock lock(s.mutex);
+      if(auto x = s.entries.find(key); x != s.entries.end()) {
+        touch(x->second);
+        return x->second.obj;
+      }
+    }
+    //объект строится без блокировки; если другой поток успел вставить такой же, используется его объект
+    auto obj = std::make_shared<const OrthYear>(make());
+    {
+      std::unique_lock lock(s.mutex);
+      auto [x, inserted] = s.entries.try_emplace(key, obj, epoch.fetch_add(1, std::memory_order_relaxed) + 1);
+      if(!inserted) {
+        touch(x->second);
+        return x->second.obj;
+      }
+      used += x->second.size;
+    }
+    evict(i);
+    return obj;
+  }
+  void set_limit(std::size_t bytes)
+  {
+    limit = bytes;
+    evict(0);
+  }
+  std::size_t get_limit() const { return limit; }
+  std::size_t memory_usage() const { return used; }
+  void pin(int cycle_year) { pinned[cycle_year] = true; }
+  void unpin(int cycle_year)
+  {
+    pinned[cycle_year] = false;
+    evict(0);
+  }
+};
+
+OrthYearCache::Entry::Entry(std::shared_ptr<const OrthYear> o, uint64_t t)
+  : obj(std::move(o)), last_use(t), size(entry_size(*obj))
+{
+}
+
+//ссылка на кэш объектов OrthYear. собственный кэш календаря копируется вместе с ним;
+//общий кэш процесса разделяется всеми календарями, которые его используют, и при копировании не копируется
+class OrthYearCacheHandle {
+
+  std::shared_ptr<OrthYearCache> ptr;
+  bool shared;
+
+  static const std::shared_ptr<OrthYearCache>& global()
+  {
+    static const auto cache = std::make_shared<OrthYearCache>();
+    return cache;
+  }
+
+public:
+
+  OrthYearCacheHandle() : ptr(std::make_shared<OrthYearCache>()), shared(false) {}
+  OrthYearCacheHandle(const OrthYearCacheHandle& other)
+    : ptr(other.shared ? other.ptr : std::make_shared<OrthYearCache>(*other.ptr)), shared(other.shared) {}
+  OrthYearCacheHandle& operator=(const OrthYearCacheHandle& other)
+  {
+    if(this != &other) {
+      OrthYearCacheHandle tmp(other);
+      std::swap(ptr, tmp.ptr);
+      std::swap(shared, tmp.shared);
+    }
+    return *this;
+  }
+  OrthYearCache* operator->() const { return ptr.get(); }
+  bool is_shared() const { return shared; }
+  void set_shared(bool value)
+  {
+    if(value == shared) return;
+    ptr = value ? global() : std::make_shared<OrthYearCache>();
+    shared = value;
+  }
+};
+
+//таблица годовой величины по годам пасхального цикла: значение для года y равно value(y % PASCHAL_CYCLE)
+//(std::nullopt - год не учитывается). Значения вычисляются при первом обращении; для диапазонов не короче цикла
+//строятся префиксные суммы, после чего количества лет с каждым значением находятся за O(кол-во значений)
+class CycleTable {
+public:
+  using Value = std::function<std::optional<int>(int)>;
+
+  explicit CycleTable(Value value) : value_(std::move(value)) {}
+
+  //добавляет в result количество лет a..b (a <= b) для каждого значения; key - ключ result для значения
+  template<typename Integer, typename Map, typename Key>
+    void add(Map& result, const Integer& a, const Integer& b, Key key)
+  {
+    const Integer n = b - a + 1;
+    const int start = static_cast<int>(a % PASCHAL_CYCLE);
+    if(n < PASCHAL_CYCLE) {
+      for(int i=0; i<n; ++i) {
+        if(const auto& v = at((start + i) % PASCHAL_CYCLE); v) result[key(*v)]++;
+      }
+      return;
+    }
+    build_prefix();
+    const Integer full = n / PASCHAL_CYCLE;
+    const int r = static_cast<int>(n % PASCHAL_CYCLE);
+    for(std::size_t i=0; i<distinct_.size(); ++i) {
+      const auto& p = prefix_[i];
+      uint64_t count = start + r <= PASCHAL_CYCLE ? p[start + r] - p[start]
+                                                  : p[PASCHAL_CYCLE] - p[start] + p[start + r - PASCHAL_CYCLE];
+      count = add_cycles(count, full, p[PASCHAL_CYCLE]);
+      if(count) {
+        auto& x = result[key(distinct_[i])];
+        x = add_cycles(x, 1, count);
+      }
+    }
+  }
+
+private:
+
+  Value value_;
+  std::array<std::optional<std::optional<int>>, PASCHAL_CYCLE> values_;
+  std::vector<int> distinct_;
+  std::vector<std::array<uint32_t, PASCHAL_CYCLE+1>> prefix_;//prefix_[i][k]: лет со значением distinct_[i] среди 0..k-1
+
+  const std::optional<int>& at(const int k)
+  {
+    if(!values_[k]) values_[k] = value_(k);
+    return *values_[k];
+  }
+
+  void build_prefix()
+  {
+    if(!distinct_.empty()) return;
+    for(int k=0; k<PASCHAL_CYCLE; ++k) {
+      if(const auto& v = at(k); v) distinct_.push_back(*v);
+    }
+    std::sort(distinct_.begin(), distinct_.end());
+    distinct_.erase(std::unique(distinct_.begin(), distinct_.end()), distinct_.end());
+    prefix_.assign(distinct_.size(), {});
+    for(int k=0; k<PASCHAL_CYCLE; ++k) {
+      const auto& v = at(k);
+      const auto i = v ? std::lower_bound(distinct_.begin(), distinct_.end(), *v) - distinct_.begin() : -1;
+      for(std::size_t j=0; j<distinct_.size(); ++j) {
+        prefix_[j][k+1] = prefix_[j][k] + (static_cast<std::ptrdiff_t>(j) == i ? 1 : 0);
+      }
+    }
+  }
+};
+
+//кол-во високосных годов календаря fmt от 1 до year включительно
+int64_t leap_years_count(const int64_t year, const CalendarFormat fmt)
+{
+  const int64_t c = year / 100;
+  switch(fmt) {
+    case Grigorian: return year/4 - c + year/400;
+    case Milankovic: return year/4 - c + c/9*2 + (c%9 >= 2) + (c%9 >= 6);
+    default: return year/4;
+  }
+}
+
+//месяц и день по смещению в днях от 1 марта (для смещений от 0 до 364; далее - январь и февраль
+//следующего года без учета 29 февраля); nullopt - смещение вне этого диапазона
+std::optional<std::pair<Month, Day>> date_from_march(int offset)
+{
+  if(offset < 0 || offset >= 365) return std::nullopt;
+  for(Month m=3; ; m = m % 12 + 1) {
+    const Day len = month_length(m, false);
+    if(offset < len) return std::make_pair(m, static_cast<Day>(offset + 1));
+    offset -= len;
+  }
+}
+
+/*----------------------------------------------------*/
+/*          class OrthodoxCalendar::impl              */
+/*----------------------------------------------------*/
+
+class OrthodoxCalendar::impl {
+
+  //настройка номеров добавочных седмиц зимней отступкu литургийных чтений
+  std::array<uint8_t,5> zimn_otstupka_n5; //при отступке в 5 седмиц.
+  std::array<uint8_t,4> zimn_otstupka_n4; //при отступке в 4 седмиц.
+  std::array<uint8_t,3> zimn_otstupka_n3; //при отступке в 3 седмиц.
+  std::array<uint8_t,2> zimn_otstupka_n2; //при отступке в 2 седмиц.
+  std::array<uint8_t,1> zimn_otstupka_n1; //при отступке в 1 седмиц.
+  //настройка номеров добавочных седмиц осенней отступкu литургийных чтений
+  std::array<uint8_t,2> osen_otstupka;
+  bool osen_otstupka_apostol; //при вычислении осенней отступкu учитывать ли апостол
+  OptionsFingerprint options_fingerprint; //все настройки выше в упакованном виде; ключ кэша
+  OrthYearCacheHandle orthyear_cache;
+
+  void update_options_fingerprint();
+
+  static int cycle_year_of(const std::string& year);
+  static int cycle_year_of(const int64_t year);
+  std::shared_ptr<const OrthYear> get_orthyear_obj(const std::string& year) const;
+  std::shared_ptr<const OrthYear> get_orthyear_obj(const int64_t year) const;
+  std::shared_ptr<const OrthYear> get_orthyear_obj(const big_int& year) const;
+  std::shared_ptr<const OrthYear> get_orthyear_obj_(const int cycle_year) const;
+  template<typename Container>
+    bool set_indent_week_numbers_option(Container& container, std::initializer_list<uint8_t> il);
+  template<typename MethodPtr, typename... Args>
+    auto get_date_option(const Date& date, MethodPtr mptr, const Args&... args) const;
+  template<typename MethodPtr, typename... Args>
+    auto get_date_option(const int64_t y, const Month m, const Day d, const CalendarFormat infmt,
+          MethodPtr mptr, const Args&... args) const;
+  //то же для значений, которые DayEvaluator вычисляет без построения (и без кэширования) объекта OrthYear
+  template<typename MethodPtr>
+    auto get_day_option(const Date& date, MethodPtr mptr) const;
+  template<typename MethodPtr>
+    auto get_day_option(const int64_t y, const Month m, const Day d, const CalendarFormat infmt, MethodPtr mptr) const;
+  //метод поиска за период, который вызывается для календарей, отличных от юлианского
+  template<typename TResult, typename TProperty>
+    using PeriodMethod = TResult (impl::*)(const Date&, const Date&, TProperty) const;
+  template<typename TYear, typename TProperty, typename OrthYearMethod>
+    Date get_date__(const TYear& year, TProperty property, const CalendarFormat infmt, OrthYearMethod orthyear_method,
+          PeriodMethod<Date, std::type_identity_t<TProperty>> period_method) const;
+  template<typename TProperty, typename OrthYearMethod>
+    Date get_date_inperiod__(const Date& d1, const Date& d2, TProperty property, OrthYearMethod orthyear_method) const;
+  template<typename TDate, typename TYear, typename TProperty, typename OrthYearMethod>
+    std::vector<TDate> get_alldates__(const TYear& year, TProperty property, const CalendarFormat infmt,
+          OrthYearMethod orthyear_method,
+          PeriodMethod<std::vector<TDate>, std::type_identity_t<TProperty>> period_method) const;
+  template<typename TDate, typename TProperty, typename OrthYearMethod>
+    std::vector<TDate> get_alldates_inperiod__(const Date& d1, const Date& d2, TProperty property,
+          OrthYearMethod orthyear_method) const;
+  template<typename TProperty, typename OrthYearMethod>
+    Date get_date_inperiod__(const Date& d1, const Date& d2, TProperty property, OrthYearMethod orthyear_method,
+          const Executor& executor) const;
+  template<typename TDate, typename TProperty, typename OrthYearMethod>
+    std::vector<TDate> get_alldates_inperiod__(const Date& d1, const Date& d2, TProperty property,
+          OrthYearMethod orthyear_method, const Executor& executor) const;
+  static void run_parallel(const Executor& executor, std::size_t n, const std::function<void(std::size_t)>& task);
+  template<typename DaysQuery>
+    CompactDatesView dates_inperiod__(const Date& d1, const Date& d2, DaysQuery query) const;
+  //дни года по его номеру в пасхальном цикле (year % PASCHAL_CYCLE)
+  using CycleDays = std::function<OrthYear::DayMask(int)>;
+  uint64_t count_inperiod__(const Date& d1, const Date& d2, const CycleDays& cycle_days, const bool any) const;
+  CompactDatesView cycle_dates_inperiod__(const Date& d1, const Date& d2, CycleDays cycle_days) const;
+  OrthYear::DayMask near_days(const int k, const DatePredicate& a, const DatePredicate& b,
+        const int min_offset, const int max_offset) const;
+  static void check_offsets(const int min_offset, const int max_offset);
+  static std::pair<int64_t, int64_t> civil_year_cjdn(const int64_t year, const CalendarFormat infmt);
+  template<typename TDate, typename TYear>
+    std::vector<TDate> fixed_dates__(const TYear& year, const ShortDate md, const CalendarFormat infmt,
+        const bool first_only) const;
+  template<typename TDate>
+    static std::vector<TDate> fixed_dates_inperiod__(const Date& d1, const Date& d2, const ShortDate md,
+        const bool first_only);
+  template<typename TYear, typename F>
+    static void year_range__(const TYear& y1, const TYear& y2, F f);
+  template<typename TYear>
+    static std::map<int8_t, uint64_t> year_histogram__(const TYear& y1, const TYear& y2, CycleTable::Value value);
+
+public:
 
   impl();
+  template<typename TDate=Date>
+    static TDate make_date(const Year& y, const Month m, const Day d, const CalendarFormat f);
+  template<typename TDate=Date>
+    static TDate make_date(const int64_t y, const Month m, const Day d, const CalendarFormat f);
   bool set_winter_indent_weeks_1(const uint8_t w1);
   bool set_winter_indent_weeks_2(const uint8_t w1, const uint8_t w2);
   bool set_winter_indent_weeks_3(const uint8_t w1, const uint8_t w2, const uint8_t w3);
@@ -4035,33 +4999,126 @@ public:
   bool set_spring_indent_weeks(const uint8_t w1, const uint8_t w2);
   void set_spring_indent_apostol(const bool value);
   std::pair<std::vector<uint8_t>, bool> get_options() const;
-  std::pair<Month, Day> julian_pascha(const Year& year) const;
-  Date pascha(const Year& year, const CalendarFormat infmt) const;
-  int8_t winter_indent(const Year& year) const;
-  int8_t spring_indent(const Year& year) const;
-  int8_t apostol_post_length(const Year& year) const;
+  //номера добавочных седмиц в порядке get_options() без выделения памяти
+  std::array<uint8_t,17> indent_options() const;
+  void set_cache_limit(const std::size_t bytes);
+  std::size_t cache_limit() const;
+  std::size_t cache_memory_usage() const;
+  void set_shared_cache(const bool value);
+  bool shared_cache() const;
+  template<typename TYear>
+    void pin_year(const TYear& year);
+  template<typename TYear>
+    void unpin_year(const TYear& year);
+  template<typename TYear>
+    std::pair<Month, Day> julian_pascha(const TYear& year) const;
+  template<typename TYear>
+    Date pascha(const TYear& year, const CalendarFormat infmt) const;
+  template<typename TYear>
+    int8_t winter_indent(const TYear& year) const;
+  template<typename TYear>
+    int8_t spring_indent(const TYear& year) const;
+  template<typename TYear>
+    int8_t apostol_post_length(const TYear& year) const;
+  template<typename TYear>
+    std::map<std::pair<Month, Day>, uint64_t> pascha_histogram(const TYear& y1, const TYear& y2,
+          const CalendarFormat outfmt) const;
+  template<typename TYear>
+    std::map<int8_t, uint64_t> winter_indent_histogram(const TYear& y1, const TYear& y2) const;
+  template<typename TYear>
+    std::map<int8_t, uint64_t> spring_indent_histogram(const TYear& y1, const TYear& y2) const;
+  template<typename TYear>
+    std::map<int8_t, uint64_t> apostol_post_length_histogram(const TYear& y1, const TYear& y2) const;
+  template<typename TYear>
+    std::map<Weekday, uint64_t> weekday_histogram(const TYear& y1, const TYear& y2, oxc_const property) const;
   auto date_glas(const Date& d) const;
+  auto date_glas(const int64_t y, const Month m, const Day d, const CalendarFormat infmt) const;
   auto date_n50(const Date& d) const;
+  auto date_n50(const int64_t y, const Month m, const Day d, const CalendarFormat infmt) const;
   std::vector<uint16_t> date_properties(const Date& d) const;
+  std::vector<uint16_t> date_properties(const int64_t y, const Month m, const Day d, const CalendarFormat infmt) const;
+  static PropertyList make_property_list(const OrthYear::PropertyMask& markers);
+  PropertyList date_property_list(const Date& d) const;
+  PropertyList date_property_list(const int64_t y, const Month m, const Day d, const CalendarFormat infmt) const;
   auto date_apostol(const Date& d) const;
+  auto date_apostol(const int64_t y, const Month m, const Day d, const CalendarFormat infmt) const;
   auto date_evangelie(const Date& d) const;
+  auto date_evangelie(const int64_t y, const Month m, const Day d, const CalendarFormat infmt) const;
   auto resurrect_evangelie(const Date& d) const;
+  auto resurrect_evangelie(const int64_t y, const Month m, const Day d, const CalendarFormat infmt) const;
+  DatesInfo dates_info(std::span<const CompactDate> dates, unsigned fields, const Executor* executor) const;
+  static YearsInfo years_info(std::span<const int64_t> years);
   bool is_date_of(const Date& d, oxc_const property) const;
-  Date get_date_with(const Year& year, oxc_const property, const CalendarFormat infmt) const;
+  bool is_date_of(const int64_t y, const Month m, const Day d, oxc_const property, const CalendarFormat infmt) const;
+  template<typename TYear>
+    Date get_date_with(const TYear& year, oxc_const property, const CalendarFormat infmt) const;
   Date get_date_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const;
-  std::vector<Date> get_alldates_with(const Year& year, oxc_const property, const CalendarFormat infmt) const;
+  Date get_date_inperiod_with(const Date& d1, const Date& d2, oxc_const property,
+        const Executor& executor) const;
+  template<typename TYear>
+    std::vector<Date> get_alldates_with(const TYear& year, oxc_const property, const CalendarFormat infmt) const;
   std::vector<Date> get_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const;
-  Date get_date_withanyof(const Year& year, std::span<oxc_const> properties, const CalendarFormat infmt) const;
+  std::vector<Date> get_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property,
+        const Executor& executor) const;
+  template<typename TYear>
+    std::vector<CompactDate> get_compact_alldates_with(const TYear& year, oxc_const property,
+          const CalendarFormat infmt) const;
+  std::vector<CompactDate> get_compact_alldates_inperiod_with(const Date& d1, const Date& d2,
+        oxc_const property) const;
+  std::vector<CompactDate> get_compact_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property,
+        const Executor& executor) const;
+  template<typename TYear>
+    Date get_date_withanyof(const TYear& year, std::span<oxc_const> properties, const CalendarFormat infmt) const;
   Date get_date_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties) const;
-  Date get_date_withallof(const Year& year, std::span<oxc_const> properties, const CalendarFormat infmt) const;
+  Date get_date_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+        const Executor& executor) const;
+  template<typename TYear>
+    Date get_date_withallof(const TYear& year, std::span<oxc_const> properties, const CalendarFormat infmt) const;
   Date get_date_inperiod_withallof(const Date& d1, const Date& d2, std::span<oxc_const> properties) const;
-  std::vector<Date> get_alldates_withanyof(const Year& year, std::span<oxc_const> properties,
-        const CalendarFormat infmt) const;
+  Date get_date_inperiod_withallof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+        const Executor& executor) const;
+  template<typename TYear>
+    std::vector<Date> get_alldates_withanyof(const TYear& year, std::span<oxc_const> properties,
+          const CalendarFormat infmt) const;
   std::vector<Date> get_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
         std::span<oxc_const> properties) const;
+  std::vector<Date> get_alldates_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+        const Executor& executor) const;
+  template<typename TYear>
+    std::vector<CompactDate> get_compact_alldates_withanyof(const TYear& year, std::span<oxc_const> properties,
+          const CalendarFormat infmt) const;
+  std::vector<CompactDate> get_compact_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
+        std::span<oxc_const> properties) const;
+  std::vector<CompactDate> get_compact_alldates_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+        const Executor& executor) const;
+  CompactDatesView dates_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const;
+  CompactDatesView dates_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties) const;
+  CompactDatesView dates_inperiod_withallof(const Date& d1, const Date& d2, std::span<oxc_const> properties) const;
+  template<typename TYear>
+    Date get_date_where(const TYear& year, DatePredicate predicate, const CalendarFormat infmt) const;
+  Date get_date_inperiod_where(const Date& d1, const Date& d2, DatePredicate predicate) const;
+  template<typename TYear>
+    std::vector<Date> get_alldates_where(const TYear& year, DatePredicate predicate, const CalendarFormat infmt) const;
+  std::vector<Date> get_alldates_inperiod_where(const Date& d1, const Date& d2, DatePredicate predicate) const;
+  CompactDatesView dates_inperiod_where(const Date& d1, const Date& d2, DatePredicate predicate) const;
+  uint64_t count_inperiod(const Date& d1, const Date& d2, DatePredicate predicate) const;
+  CompactDatesView dates_inperiod_near(const Date& d1, const Date& d2, DatePredicate a, DatePredicate b,
+        const int min_offset, const int max_offset) const;
+  std::vector<CompactDate> get_alldates_inperiod_near(const Date& d1, const Date& d2, DatePredicate a,
+        DatePredicate b, const int min_offset, const int max_offset) const;
+  uint64_t count_inperiod_near(const Date& d1, const Date& d2, DatePredicate a, DatePredicate b,
+        const int min_offset, const int max_offset) const;
+  bool exists_inperiod(const Date& d1, const Date& d2, DatePredicate predicate) const;
+  template<typename DaysQuery>
+    Date adjacent_date__(const Date& from, DaysQuery query, const bool forward) const;
+  Date adjacent_date_with(const Date& from, oxc_const property, const bool forward) const;
+  Date adjacent_date_withanyof(const Date& from, std::span<oxc_const> properties, const bool forward) const;
+  Date adjacent_date_withallof(const Date& from, std::span<oxc_const> properties, const bool forward) const;
+  Date adjacent_date_where(const Date& from, DatePredicate predicate, const bool forward) const;
   std::string get_description_for_date(const Date& d, std::string& datefmt) const;
-  std::string get_description_for_dates(std::span<const Date> days, std::string& datefmt,
-        const std::string& separator) const;
+  template<typename TDate>
+    std::string get_description_for_dates(std::span<const TDate> days, std::string& datefmt,
+          const std::string& separator) const;
 };
 
 OrthodoxCalendar::impl::impl() :
@@ -4073,24 +5130,60 @@ OrthodoxCalendar::impl::impl() :
     osen_otstupka              {10,11},
     osen_otstupka_apostol      {false}
 {
+  update_options_fingerprint();
 }
 
-OrthYear& OrthodoxCalendar::impl::get_orthyear_obj(const std::string& year) const
+void OrthodoxCalendar::impl::update_options_fingerprint()
 {
-  auto [indent_opts, apostol_opt] = get_options();
-  std::string indent_opts_str;
-  for(const auto x: indent_opts) indent_opts_str += std::to_string(x);
-  std::string key (year + indent_opts_str + std::to_string(apostol_opt));
-  if(auto x = orthyear_cache.find(key); x != orthyear_cache.end()) {
-    return x->second;
-  } else {
-    if(orthyear_cache.size() == 10000) orthyear_cache.clear();
-    auto [it, inserted] = orthyear_cache.try_emplace(key, year, indent_opts, apostol_opt);
-    if(!inserted)
-      throw std::runtime_error("ошибка создания объекта OrthYear("+year+", "+indent_opts_str+", "
-                                +std::to_string(apostol_opt)+")");
-    return it->second;
-  }
+  OptionsFingerprint f;
+  int bit{};
+  auto pack = [&f, &bit](uint64_t x, int width){
+    f.words[bit/64] |= x << (bit%64);
+    if(bit%64 + width > 64) f.words[bit/64 + 1] |= x >> (64 - bit%64);
+    bit += width;
+  };
+  for(std::span<const uint8_t> c: {std::span<const uint8_t>(zimn_otstupka_n1), std::span<const uint8_t>(zimn_otstupka_n2),
+                                  std::span<const uint8_t>(zimn_otstupka_n3), std::span<const uint8_t>(zimn_otstupka_n4),
+                                  std::span<const uint8_t>(zimn_otstupka_n5), std::span<const uint8_t>(osen_otstupka)})
+    for(auto x: c) pack(x, 6);
+  pack(osen_otstupka_apostol, 1);
+  options_fingerprint = f;
+}
+
+int OrthodoxCalendar::impl::cycle_year_of(const std::string& year)
+{
+  if(auto x = string_to_fast_int(year); x) return cycle_year_of(*x);
+  return static_cast<int>(string_to_year(year) % PASCHAL_CYCLE);
+}
+
+int OrthodoxCalendar::impl::cycle_year_of(const int64_t year)
+{
+  return static_cast<int>(check_year(year) % PASCHAL_CYCLE);
+}
+
+std::shared_ptr<const OrthYear> OrthodoxCalendar::impl::get_orthyear_obj(const std::string& year) const
+{
+  return get_orthyear_obj_(cycle_year_of(year));
+}
+
+std::shared_ptr<const OrthYear> OrthodoxCalendar::impl::get_orthyear_obj(const int64_t year) const
+{
+  return get_orthyear_obj_(cycle_year_of(year));
+}
+
+std::shared_ptr<const OrthYear> OrthodoxCalendar::impl::get_orthyear_obj(const big_int& year) const
+{
+  if( year < MIN_YEAR_VALUE )
+    throw std::out_of_range("выход числа года '"+year.str()+"' за границу диапазона");
+  return get_orthyear_obj_(static_cast<int>(year % PASCHAL_CYCLE));
+}
+
+std::shared_ptr<const OrthYear> OrthodoxCalendar::impl::get_orthyear_obj_(const int cycle_year) const
+{ //объект OrthYear строится для представителя класса вычетов cycle_year + PASCHAL_CYCLE
+  return orthyear_cache->get({cycle_year, options_fingerprint}, [this, cycle_year]{
+    auto [indent_opts, apostol_opt] = get_options();
+    return OrthYear(int64_t{cycle_year} + PASCHAL_CYCLE, indent_opts, apostol_opt);
+  });
 }
 
 template<typename Container>
@@ -4099,29 +5192,105 @@ template<typename Container>
   if( std::any_of(il.begin(), il.end(), [](auto i){ return i<1 || i>33; }) ) return false;
   if( !std::equal(container.cbegin(), container.cend(), il.begin()) ) {
     std::copy(il.begin(), il.end(), container.begin());
+    update_options_fingerprint();
   }
   return true;
 }
 
+template<typename TDate>
+  TDate OrthodoxCalendar::impl::make_date(const Year& y, const Month m, const Day d, const CalendarFormat f)
+{
+  return TDate(y, m, d, f);
+}
+
+template<typename TDate>
+  TDate OrthodoxCalendar::impl::make_date(const int64_t y, const Month m, const Day d, const CalendarFormat f)
+{
+  if(y < MIN_YEAR_VALUE)
+    throw std::runtime_error(std::string(invalid_date)+" '"+std::to_string(y)+'.'+std::to_string(m)+'.'
+                              +std::to_string(d)+'\'');
+  return TDate(static_cast<unsigned long long>(y), m, d, f);
+}
+
+template<typename MethodPtr, typename... Args>
+    auto OrthodoxCalendar::impl::get_date_option(const Date& date, MethodPtr mptr, const Args&... args) const
+{ //для дат с cjdn в пределах int64_t год и день года вычисляются без строкового представления года
+  if(!date) throw std::runtime_error(invalid_date);
+  if(const auto c = date.pimpl->cjdn64(); c) {
+    const int64_t j = julian_year_of(*c);
+    const auto orthyear_obj = get_orthyear_obj(j);
+    const auto [m, d] = orthyear_obj->day_date(static_cast<int>(*c - julian_year_start(j)));
+    return (orthyear_obj.get()->*mptr)(m, d, args...);
+  }
+  const auto orthyear_obj = get_orthyear_obj(date.year(Julian));
+  return (orthyear_obj.get()->*mptr)(date.month(Julian), date.day(Julian), args...);
+}
+
+template<typename MethodPtr, typename... Args>
+    auto OrthodoxCalendar::impl::get_date_option(const int64_t y, const Month m, const Day d,
+          const CalendarFormat infmt, MethodPtr mptr, const Args&... args) const
+{
+  if(infmt != Julian) return get_date_option(make_date(y, m, d, infmt), mptr, args...);
+  if(y < MIN_YEAR_VALUE || !Date::check(static_cast<unsigned long long>(y), m, d, Julian))
+    throw std::runtime_error(std::string(invalid_date)+" '"+std::to_string(y)+'.'+std::to_string(m)+'.'
+                              +std::to_string(d)+'\'');
+  const auto orthyear_obj = get_orthyear_obj(y);
+  return (orthyear_obj.get()->*mptr)(m, d, args...);
+}
+
 template<typename MethodPtr>
-    auto OrthodoxCalendar::impl::get_date_option(const Date& date, MethodPtr mptr) const
+    auto OrthodoxCalendar::impl::get_day_option(const Date& date, MethodPtr mptr) const
 {
   if(!date) throw std::runtime_error(invalid_date);
-  const auto& orthyear_obj = get_orthyear_obj(date.year(Julian));
-  return (&orthyear_obj->*mptr)(date.month(Julian), date.day(Julian));
+  if(const auto c = date.pimpl->cjdn64(); c) {
+    const int64_t j = julian_year_of(*c);
+    const DayEvaluator evaluator(cycle_year_of(j), indent_options(), osen_otstupka_apostol);
+    return (evaluator.*mptr)(static_cast<int>(*c - julian_year_start(j)));
+  }
+  const DayEvaluator evaluator(cycle_year_of(date.year(Julian)), indent_options(), osen_otstupka_apostol);
+  return (evaluator.*mptr)(evaluator.day_index(date.month(Julian), date.day(Julian)));
+}
+
+template<typename MethodPtr>
+    auto OrthodoxCalendar::impl::get_day_option(const int64_t y, const Month m, const Day d,
+          const CalendarFormat infmt, MethodPtr mptr) const
+{
+  if(infmt != Julian) return get_day_option(make_date(y, m, d, infmt), mptr);
+  if(y < MIN_YEAR_VALUE || !Date::check(static_cast<unsigned long long>(y), m, d, Julian))
+    throw std::runtime_error(std::string(invalid_date)+" '"+std::to_string(y)+'.'+std::to_string(m)+'.'
+                              +std::to_string(d)+'\'');
+  const DayEvaluator evaluator(cycle_year_of(y), indent_options(), osen_otstupka_apostol);
+  return (evaluator.*mptr)(evaluator.day_index(m, d));
+}
+
+std::pair<int64_t, int64_t> OrthodoxCalendar::impl::civil_year_cjdn(const int64_t year, const CalendarFormat infmt)
+{ //первый и последний день года year календаря infmt
+  const auto y = static_cast<unsigned long long>(check_year(year));
+  return { CompactDate(y, 1, 1, infmt).cjdn(), CompactDate(y, 12, 31, infmt).cjdn() };
 }
 
-template<typename TProperty, typename OrthYearMethod, typename SelfPeriodMethod>
-  Date OrthodoxCalendar::impl::get_date__(const Year& year, TProperty property, const CalendarFormat infmt,
-        OrthYearMethod orthyear_method, SelfPeriodMethod period_method) const
+template<typename TYear, typename TProperty, typename OrthYearMethod>
+  Date OrthodoxCalendar::impl::get_date__(const TYear& year, TProperty property, const CalendarFormat infmt,
+        OrthYearMethod orthyear_method, PeriodMethod<Date, std::type_identity_t<TProperty>> period_method) const
 {
   if(infmt==Julian) {
-    const auto& orthyear_obj = get_orthyear_obj(year);
-    if(auto x = (&orthyear_obj->*orthyear_method)(property); x) {
-      return Date (year, x->first, x->second, Julian);
+    const auto orthyear_obj = get_orthyear_obj(year);
+    if(auto x = (orthyear_obj.get()->*orthyear_method)(property); x) {
+      return make_date(year, x->first, x->second, Julian);
     } else return {};
+  } else if(const auto y = fast_year(year); y) {
+    //гражданский год пересекается не более чем с двумя юлианскими; даты сравниваются по cjdn
+    const auto [first, last] = civil_year_cjdn(*y, infmt);
+    for(int64_t j = julian_year_of(first); j <= julian_year_of(last); ++j) {
+      const auto orthyear_obj = get_orthyear_obj(j);
+      if(auto x = (orthyear_obj.get()->*orthyear_method)(property); x) {
+        const int64_t c = julian_to_cjdn(j, x->first, x->second);
+        if( c >= first && c <= last ) return CompactDate::from_cjdn(c);
+      }
+    }
+    return {};
   } else {
-    return (this->*period_method)(Date(year, 1, 1, infmt), Date(year, 12, 31, infmt), property);
+    return (this->*period_method)(make_date(year, 1, 1, infmt), make_date(year, 12, 31, infmt), property);
   }
 }
 
@@ -4131,12 +5300,29 @@ template<typename TProperty, typename OrthYearMethod>
 {
   if(!d1 || !d2) throw std::runtime_error(invalid_date);
   auto [min, max] = std::minmax(d1, d2);
+  //за первым годом следуют все PASCHAL_CYCLE вариантов OrthYear целиком внутри периода; дальше они повторяются
+  if(const auto y1 = fast_year(min.year(Julian)); y1) {
+    //годы в пределах int64_t: даты сравниваются по cjdn, без big_int и строк
+    const auto y2 = fast_year(max.year(Julian));
+    const int64_t end = y2 ? std::min(*y2, *y1 + PASCHAL_CYCLE) : *y1 + PASCHAL_CYCLE;
+    const int64_t c1 = CompactDate(min).cjdn();
+    const int64_t c2 = y2 ? CompactDate(max).cjdn() : std::numeric_limits<int64_t>::max();
+    for(int64_t y = *y1; y <= end; ++y) {
+      const auto orthyear_obj = get_orthyear_obj(y);
+      if(auto x = (orthyear_obj.get()->*orthyear_method)(property); x) {
+        const int64_t c = julian_to_cjdn(y, x->first, x->second);
+        if(c >= c1 && c <= c2) return CompactDate::from_cjdn(c);
+      }
+    }
+    return {};
+  }
   auto a = string_to_year(min.year(Julian));
   auto b = string_to_year(max.year(Julian)) + 1;
+  if(b - a > PASCHAL_CYCLE + 1) b = a + PASCHAL_CYCLE + 1;
   while(a<b) {
     std::string y = a.str();
-    const auto& orthyear_obj = get_orthyear_obj(y);
-    if(auto x = (&orthyear_obj->*orthyear_method)(property); x) {
+    const auto orthyear_obj = get_orthyear_obj(y);
+    if(auto x = (orthyear_obj.get()->*orthyear_method)(property); x) {
       Date result(y, x->first, x->second, Julian);
       if( result >= min && result <= max ) return result;
     }
@@ -4145,505 +5331,1933 @@ template<typename TProperty, typename OrthYearMethod>
   return {};
 }
 
-template<typename TProperty, typename OrthYearMethod, typename SelfPeriodMethod>
-  std::vector<Date> OrthodoxCalendar::impl::get_alldates__(const Year& year, TProperty property,
-        const CalendarFormat infmt, OrthYearMethod orthyear_method, SelfPeriodMethod period_method) const
+template<typename TDate, typename TYear, typename TProperty, typename OrthYearMethod>
+  std::vector<TDate> OrthodoxCalendar::impl::get_alldates__(const TYear& year, TProperty property,
+        const CalendarFormat infmt, OrthYearMethod orthyear_method,
+        PeriodMethod<std::vector<TDate>, std::type_identity_t<TProperty>> period_method) const
 {
   if(infmt==Julian) {
-    const auto& orthyear_obj = get_orthyear_obj(year);
-    if(auto x = (&orthyear_obj->*orthyear_method)(property); x) {
-      std::vector<Date> result;
+    const auto orthyear_obj = get_orthyear_obj(year);
+    if(auto x = (orthyear_obj.get()->*orthyear_method)(property); x) {
+      std::vector<TDate> result;
       result.reserve(x->size()) ;
       std::transform(x->begin(), x->end(), std::back_inserter(result), [&year](const auto& e){
-          return Date(year, e.first, e.second, Julian);
+          return make_date<TDate>(year, e.first, e.second, Julian);
       });
       return result;
     }
     else return {};
+  } else if(const auto y = fast_year(year); y) {
+    std::vector<TDate> result;
+    const auto [first, last] = civil_year_cjdn(*y, infmt);
+    for(int64_t j = julian_year_of(first); j <= julian_year_of(last); ++j) {
+      const auto orthyear_obj = get_orthyear_obj(j);
+      if(auto x = (orthyear_obj.get()->*orthyear_method)(property); x) {
+        for(const auto& e: *x) {
+          const int64_t c = julian_to_cjdn(j, e.first, e.second);
+          if( c >= first && c <= last ) result.push_back(TDate(CompactDate::from_cjdn(c)));
+        }
+      }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
   } else {
-    return (this->*period_method)(Date(year, 1, 1, infmt), Date(year, 12, 31, infmt), property);
+    return (this->*period_method)(make_date(year, 1, 1, infmt), make_date(year, 12, 31, infmt), property);
   }
 }
 
-template<typename TProperty, typename OrthYearMethod>
-  std::vector<Date> OrthodoxCalendar::impl::get_alldates_inperiod__(const Date& d1, const Date& d2,
+template<typename TDate, typename TProperty, typename OrthYearMethod>
+  std::vector<TDate> OrthodoxCalendar::impl::get_alldates_inperiod__(const Date& d1, const Date& d2,
         TProperty property, OrthYearMethod orthyear_method) const
-{
+{ //годы перебираются по возрастанию, поэтому сортируются только даты каждого года
+  //(методы OrthYear возвращают их в порядке признаков, повторы сохраняются)
   if(!d1 || !d2) throw std::runtime_error(invalid_date);
-  std::vector<Date> semiresult, result;
+  std::vector<TDate> result;
   auto [min, max] = std::minmax(d1, d2);
+  const TDate first(min), last(max);
+  if(const auto y1 = fast_year(min.year(Julian)), y2 = fast_year(max.year(Julian)); y1 && y2) {
+    //годы в пределах int64_t: даты сравниваются по cjdn, без big_int и строк
+    const int64_t c1 = CompactDate(min).cjdn(), c2 = CompactDate(max).cjdn();
+    for(int64_t y = *y1; y <= *y2; ++y) {
+      const auto orthyear_obj = get_orthyear_obj(y);
+      if(auto x = (orthyear_obj.get()->*orthyear_method)(property); x) {
+        const auto n = result.size();
+        for(const auto& e: *x) {
+          const int64_t c = julian_to_cjdn(y, e.first, e.second);
+          if(c >= c1 && c <= c2) result.push_back(TDate(CompactDate::from_cjdn(c)));
+        }
+        std::sort(result.begin() + n, result.end());
+      }
+    }
+    return result;
+  }
   auto a = string_to_year(min.year(Julian));
   auto b = string_to_year(max.year(Julian)) + 1;
   while(a<b) {
     std::string y = a.str();
-    const auto& orthyear_obj = get_orthyear_obj(y);
-    if(auto x = (&orthyear_obj->*orthyear_method)(property); x) {
-      std::transform(x->begin(), x->end(), std::back_inserter(semiresult), [&y](const auto& e){
-          return Date(y, e.first, e.second, Julian);
-      });
+    const auto orthyear_obj = get_orthyear_obj(y);
+    if(auto x = (orthyear_obj.get()->*orthyear_method)(property); x) {
+      const auto n = result.size();
+      for(const auto& e: *x) {
+        TDate d(y, e.first, e.second, Julian);
+        if(d >= first && d <= last) result.push_back(std::move(d));
+      }
+      std::sort(result.begin() + n, result.end());
     }
     a++;
   }
-  if(semiresult.empty()) return {};
-  std::sort(semiresult.begin(), semiresult.end());
-  auto begin = std::lower_bound(semiresult.begin(), semiresult.end(), min);
-  if(begin==semiresult.end()) return {};
-  auto end = std::upper_bound(semiresult.begin(), semiresult.end(), max);
-  result.reserve(semiresult.size());
-  std::copy(begin, end, std::back_inserter(result));
-  result.shrink_to_fit();
   return result;
 }
 
-bool OrthodoxCalendar::impl::set_winter_indent_weeks_1(const uint8_t w1)
-{
-  return set_indent_week_numbers_option(zimn_otstupka_n1, {w1});
+void OrthodoxCalendar::impl::run_parallel(const Executor& executor, std::size_t n,
+      const std::function<void(std::size_t)>& task)
+{ //исключение из задачи не должно попасть в исполнитель: первое из них пробрасывается после его завершения
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  const std::function<void(std::size_t)> guarded_task = [&](std::size_t i){
+    try {
+      task(i);
+    } catch(...) {
+      std::lock_guard lock(error_mutex);
+      if(!error) error = std::current_exception();
+    }
+  };
+  if(executor) {
+    executor(n, guarded_task);
+  } else {
+    static const Executor default_executor = thread_executor();
+    default_executor(n, guarded_task);
+  }
+  if(error) std::rethrow_exception(error);
 }
 
-bool OrthodoxCalendar::impl::set_winter_indent_weeks_2(const uint8_t w1, const uint8_t w2)
-{
-  return set_indent_week_numbers_option(zimn_otstupka_n2, {w1, w2});
+template<typename TProperty, typename OrthYearMethod>
+  Date OrthodoxCalendar::impl::get_date_inperiod__(const Date& d1, const Date& d2, TProperty property,
+        OrthYearMethod orthyear_method, const Executor& executor) const
+{ //задача i обрабатывает годы [a + i*YEARS_PER_TASK, a + (i+1)*YEARS_PER_TASK)
+  if(!d1 || !d2) throw std::runtime_error(invalid_date);
+  auto [min, max] = std::minmax(d1, d2);
+  const auto a = string_to_fast_int(min.year(Julian));
+  const auto b = string_to_fast_int(max.year(Julian));
+  if(!a || !b) return get_date_inperiod__(d1, d2, property, orthyear_method);
+  //как и в последовательной версии, после первого года достаточно просмотреть один цикл PASCHAL_CYCLE
+  const int64_t end = std::min(*b, *a + PASCHAL_CYCLE);
+  const auto n = static_cast<std::size_t>((end - *a) / YEARS_PER_TASK + 1);
+  //даты сравниваются с границами периода по cjdn
+  const int64_t c1 = CompactDate(min).cjdn(), c2 = CompactDate(max).cjdn();
+  std::vector<Date> results(n);
+  std::atomic<std::size_t> found = n;//номер первой задачи, нашедшей дату; задачи с большими номерами не нужны
+  run_parallel(executor, n, [&](std::size_t i){
+    const int64_t first = *a + static_cast<int64_t>(i) * YEARS_PER_TASK;
+    const int64_t last = std::min(end, first + YEARS_PER_TASK - 1);
+    for(int64_t y = first; y <= last && i < found.load(std::memory_order_relaxed); ++y) {
+      const auto orthyear_obj = get_orthyear_obj(y);
+      if(auto x = (orthyear_obj.get()->*orthyear_method)(property); x) {
+        if(const int64_t c = julian_to_cjdn(y, x->first, x->second); c >= c1 && c <= c2) {
+          results[i] = CompactDate::from_cjdn(c);
+          auto f = found.load();
+          while(i < f && !found.compare_exchange_weak(f, i)) {}
+          return;
+        }
+      }
+    }
+  });
+  if(const auto f = found.load(); f < n) return results[f];
+  return {};
 }
 
-bool OrthodoxCalendar::impl::set_winter_indent_weeks_3(const uint8_t w1, const uint8_t w2, const uint8_t w3)
+template<typename TDate, typename TProperty, typename OrthYearMethod>
+  std::vector<TDate> OrthodoxCalendar::impl::get_alldates_inperiod__(const Date& d1, const Date& d2,
+        TProperty property, OrthYearMethod orthyear_method, const Executor& executor) const
+{ //задача i обрабатывает годы [a + i*YEARS_PER_TASK, a + (i+1)*YEARS_PER_TASK); части склеиваются по порядку.
+  //задачи передаются исполнителю волнами по TASKS_PER_WAVE, поэтому память под части не зависит от длины периода
+  if(!d1 || !d2) throw std::runtime_error(invalid_date);
+  auto [min, max] = std::minmax(d1, d2);
+  const auto a = string_to_fast_int(min.year(Julian));
+  const auto b = string_to_fast_int(max.year(Julian));
+  if(!a || !b) return get_alldates_inperiod__<TDate>(d1, d2, property, orthyear_method);
+  const int64_t tasks = (*b - *a) / YEARS_PER_TASK + 1;
+  //как и в последовательной версии, даты сравниваются с границами периода по cjdn
+  const int64_t c1 = CompactDate(min).cjdn(), c2 = CompactDate(max).cjdn();
+  std::vector<TDate> result;
+  std::vector<std::vector<TDate>> parts;
+  for(int64_t wave = 0; wave < tasks; wave += TASKS_PER_WAVE) {
+    const auto n = static_cast<std::size_t>(std::min(TASKS_PER_WAVE, tasks - wave));
+    parts.assign(n, {});
+    run_parallel(executor, n, [&](std::size_t i){
+      const int64_t first = *a + (wave + static_cast<int64_t>(i)) * YEARS_PER_TASK;
+      const int64_t last = std::min(*b, first + YEARS_PER_TASK - 1);
+      for(int64_t y = first; y <= last; ++y) {
+        const auto orthyear_obj = get_orthyear_obj(y);
+        if(auto x = (orthyear_obj.get()->*orthyear_method)(property); x) {
+          auto& part = parts[i];
+          const auto n = part.size();
+          for(const auto& e: *x) {
+            const int64_t c = julian_to_cjdn(y, e.first, e.second);
+            if(c >= c1 && c <= c2) part.push_back(TDate(CompactDate::from_cjdn(c)));
+          }
+          std::sort(part.begin() + n, part.end());
+        }
+      }
+    });
+    std::size_t count = result.size();
+    for(const auto& x: parts) count += x.size();
+    result.reserve(count);
+    for(auto& x: parts) std::move(x.begin(), x.end(), std::back_inserter(result));
+  }
+  return result;
+}
+
+/*----------------------------------------------------*/
+/*      class OrthodoxCalendar::CompactDatesView      */
+/*----------------------------------------------------*/
+
+struct OrthodoxCalendar::CompactDatesView::state {
+  using CycleDays = std::function<OrthYear::DayMask(int)>;
+
+  CycleDays cycle_days;//дни года по его номеру в пасхальном цикле (year % PASCHAL_CYCLE)
+  int64_t year;//следующий год для перебора (по юлианскому календарю)
+  int64_t last_year;
+  int64_t min;//границы периода (CJDN)
+  int64_t max;
+  int64_t year_start{};//CJDN 1 января года, к которому относится days
+  OrthYear::DayMask days;//еще не выданные дни текущего года
+  BitMask<PASCHAL_CYCLE> empty_cycle_years;//остатки year % PASCHAL_CYCLE, для которых запрос не дает ни одного дня
+  CompactDate current;
+  bool started{};
+  bool finished{};
+
+  void next()
+  {
+    while(!finished) {
+      if(const int i = days.find_first(); i >= 0) {
+        days.reset(i);
+        if(i > max - year_start) break;//year_start + i > max без переполнения у верхней границы int64_t
+        const int64_t cjdn = year_start + i;
+        if(cjdn < min) continue;
+        current = CompactDate::from_cjdn(cjdn);
+        return;
+      }
+      if(year > last_year) break;
+      const int k = static_cast<int>(year % PASCHAL_CYCLE);
+      if(empty_cycle_years.test(k)) { //переход сразу к ближайшему году с непустым остатком
+        int i = 1;
+        while(empty_cycle_years.test((k + i) % PASCHAL_CYCLE)) ++i;
+        year += i;
+        continue;
+      }
+      days = cycle_days(k);
+      if(!days.any()) {
+        empty_cycle_years.set(k);
+        if(empty_cycle_years.count() == PASCHAL_CYCLE) break;
+      }
+      year_start = julian_year_start(year);
+      ++year;
+    }
+    finished = true;
+    current = {};
+  }
+};
+
+const CompactDate& OrthodoxCalendar::CompactDatesView::iterator::operator*() const
 {
-  return set_indent_week_numbers_option(zimn_otstupka_n3, {w1, w2, w3});
+  return st->current;
 }
 
-bool OrthodoxCalendar::impl::set_winter_indent_weeks_4(const uint8_t w1, const uint8_t w2,
+OrthodoxCalendar::CompactDatesView::iterator& OrthodoxCalendar::CompactDatesView::iterator::operator++()
+{
+  st->next();
+  return *this;
+}
+
+bool OrthodoxCalendar::CompactDatesView::iterator::operator==(std::default_sentinel_t) const
+{
+  return !st || st->finished;
+}
+
+OrthodoxCalendar::CompactDatesView::iterator OrthodoxCalendar::CompactDatesView::begin() const
+{
+  if(st && !st->started) {
+    st->started = true;
+    st->next();
+  }
+  return iterator(st.get());
+}
+
+template<typename DaysQuery>
+  OrthodoxCalendar::CompactDatesView OrthodoxCalendar::impl::dates_inperiod__(const Date& d1, const Date& d2,
+        DaysQuery query) const
+{
+  return cycle_dates_inperiod__(d1, d2, [this, query = std::move(query)](int k){
+    return query(*get_orthyear_obj_(k));
+  });
+}
+
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::impl::dates_inperiod_with(const Date& d1, const Date& d2,
+      oxc_const property) const
+{
+  return dates_inperiod__(d1, d2, [property](const OrthYear& y){
+    return y.days_withanyof(std::span<oxc_const>(&property, 1));
+  });
+}
+
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::impl::dates_inperiod_withanyof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
+{
+  return dates_inperiod__(d1, d2, [m = std::vector<uint16_t>(properties.begin(), properties.end())](const OrthYear& y){
+    return y.days_withanyof(m);
+  });
+}
+
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::impl::dates_inperiod_withallof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
+{
+  return dates_inperiod__(d1, d2, [m = std::vector<uint16_t>(properties.begin(), properties.end())](const OrthYear& y){
+    return y.days_withallof(m);
+  });
+}
+
+template<typename TYear>
+  Date OrthodoxCalendar::impl::get_date_where(const TYear& year, DatePredicate predicate,
+        const CalendarFormat infmt) const
+{ //гражданский год пересекается с двумя юлианскими, поэтому для него первая дата ищется как в периоде
+  if(infmt != Julian) {
+    return get_date_inperiod_where(make_date(year, 1, 1, infmt), make_date(year, 12, 31, infmt), std::move(predicate));
+  }
+  return get_date__(year, std::move(predicate), infmt, &OrthYear::get_date_where, &impl::get_date_inperiod_where);
+}
+
+Date OrthodoxCalendar::impl::get_date_inperiod_where(const Date& d1, const Date& d2, DatePredicate predicate) const
+{ //дни первого и последнего года ограничиваются границами периода, поэтому находится первая дата периода,
+  //а не первая дата года. после первого года достаточно просмотреть один цикл PASCHAL_CYCLE
+  if(!d1 || !d2) throw std::runtime_error(invalid_date);
+  auto [min, max] = std::minmax(d1, d2);
+  const auto [y1, m1, day1] = min.ymd(Julian);
+  const auto [y2, m2, day2] = max.ymd(Julian);
+  auto find = [&](const auto& a, const auto& b) -> Date {
+    using Integer = std::remove_cvref_t<decltype(a)>;
+    const Integer end = b - a > PASCHAL_CYCLE ? Integer(a + PASCHAL_CYCLE) : b;
+    for(Integer y = a; y <= end; ++y) {
+      const auto orthyear_obj = get_orthyear_obj(y);
+      auto days = orthyear_obj->days_where(predicate);
+      if(y == a || y == b) {
+        days &= orthyear_obj->days_between(y == a ? ShortDate{m1, day1} : ShortDate{1, 1},
+                                           y == b ? ShortDate{m2, day2} : ShortDate{12, 31});
+      }
+      if(const int i = days.find_first(); i >= 0) {
+        if constexpr(std::is_same_v<Integer, int64_t>) {
+          return CompactDate::from_cjdn(julian_year_start(y) + i);
+        } else {
+          const auto [m, d] = orthyear_obj->day_date(i);
+          return Date(y.str(), m, d, Julian);
+        }
+      }
+    }
+    return {};
+  };
+  const auto a = string_to_fast_int(y1);
+  const auto b = string_to_fast_int(y2);
+  if(a && b) return find(*a, *b);
+  return find(string_to_year(y1), string_to_year(y2));
+}
+
+template<typename TYear>
+  std::vector<Date> OrthodoxCalendar::impl::get_alldates_where(const TYear& year, DatePredicate predicate,
+        const CalendarFormat infmt) const
+{
+  return get_alldates__<Date>(year, std::move(predicate), infmt, &OrthYear::get_alldates_where,
+                                                             &impl::get_alldates_inperiod_where);
+}
+
+std::vector<Date> OrthodoxCalendar::impl::get_alldates_inperiod_where(const Date& d1, const Date& d2,
+      DatePredicate predicate) const
+{
+  return get_alldates_inperiod__<Date>(d1, d2, std::move(predicate), &OrthYear::get_alldates_where);
+}
+
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::impl::dates_inperiod_where(const Date& d1, const Date& d2,
+      DatePredicate predicate) const
+{
+  return dates_inperiod__(d1, d2, [predicate = std::move(predicate)](const OrthYear& y){
+    return y.days_where(predicate);
+  });
+}
+
+template<typename TDate, typename TYear>
+  std::vector<TDate> OrthodoxCalendar::impl::fixed_dates__(const TYear& year, const ShortDate md,
+        const CalendarFormat infmt, const bool first_only) const
+{
+  if(infmt != Julian) {
+    return fixed_dates_inperiod__<TDate>(make_date(year, 1, 1, infmt), make_date(year, 12, 31, infmt), md, first_only);
+  }
+  cycle_year_of(year);//проверка допустимости числа года
+  return { make_date<TDate>(year, md.first, md.second, Julian) };
+}
+
+template<typename TDate>
+  std::vector<TDate> OrthodoxCalendar::impl::fixed_dates_inperiod__(const Date& d1, const Date& d2,
+        const ShortDate md, const bool first_only)
+{ //непереходящая дата встречается в каждом юлианском году ровно один раз, объекты OrthYear не нужны
+  if(!d1 || !d2) throw std::runtime_error(invalid_date);
+  std::vector<TDate> result;
+  auto [min, max] = std::minmax(d1, d2);
+  const TDate first(min), last(max);
+  auto loop = [&](auto a, const auto& b){
+    for(; a <= b; ++a) {
+      TDate d;
+      if constexpr(std::is_same_v<decltype(a), big_int>) d = make_date<TDate>(a.str(), md.first, md.second, Julian);
+      else d = make_date<TDate>(a, md.first, md.second, Julian);
+      if(d < first) continue;
+      if(d > last) return;
+      result.push_back(std::move(d));
+      if(first_only) return;
+    }
+  };
+  const auto y1 = min.year(Julian);
+  const auto y2 = max.year(Julian);
+  const auto a = string_to_fast_int(y1);
+  const auto b = string_to_fast_int(y2);
+  if(a && b) {
+    loop(*a, *b);
+  } else {
+    loop(string_to_year(y1), string_to_year(y2));
+  }
+  return result;
+}
+
+uint64_t OrthodoxCalendar::impl::count_inperiod__(const Date& d1, const Date& d2, const CycleDays& cycle_days,
+      const bool any) const
+{ //набор дней года зависит только от year % PASCHAL_CYCLE, поэтому годы между граничными считаются
+  //по таблице количеств для всех вариантов года и время расчета не зависит от длины периода.
+  //с границами периода сравниваются только дни первого и последнего года; any - достаточно первого найденного дня
+  if(!d1 || !d2) throw std::runtime_error(invalid_date);
+  auto [min, max] = std::minmax(d1, d2);
+  const auto [y1, m1, day1] = min.ymd(Julian);
+  const auto [y2, m2, day2] = max.ymd(Julian);
+  auto count = [&](const auto& a, const auto& b) -> uint64_t {
+    using Integer = std::remove_cvref_t<decltype(a)>;
+    auto year_count = [&](const Integer& y, ShortDate first, ShortDate last) -> uint64_t {
+      const auto orthyear_obj = get_orthyear_obj(y);
+      auto days = cycle_days(static_cast<int>(y % PASCHAL_CYCLE));
+      days &= orthyear_obj->days_between(first, last);
+      return days.count();
+    };
+    auto cycle_year_count = [&](int k) -> uint64_t {
+      return cycle_days(k).count();
+    };
+    if(a == b) return year_count(a, {m1, day1}, {m2, day2});
+    uint64_t result = year_count(a, {m1, day1}, {12, 31});
+    if(any && result) return result;
+    result += year_count(b, {1, 1}, {m2, day2});
+    if(any && result) return result;
+    const Integer n = b - a - 1;//полные годы a+1 .. b-1
+    const int start = static_cast<int>((a + 1) % PASCHAL_CYCLE);
+    if(n < PASCHAL_CYCLE) {
+      for(int i=0; i<n; ++i) {
+        result += cycle_year_count((start + i) % PASCHAL_CYCLE);
+        if(any && result) return result;
+      }
+      return result;
+    }
+    std::array<uint64_t, PASCHAL_CYCLE> per_year;
+    uint64_t total{};
+    for(int k=0; k<PASCHAL_CYCLE; ++k) {
+      per_year[k] = cycle_year_count(k);
+      total += per_year[k];
+      if(any && total) return total;
+    }
+    const int r = static_cast<int>(n % PASCHAL_CYCLE);
+    for(int i=0; i<r; ++i) result += per_year[(start + i) % PASCHAL_CYCLE];
+    return add_cycles(result, n / PASCHAL_CYCLE, total);
+  };
+  const auto a = string_to_fast_int(y1);
+  const auto b = string_to_fast_int(y2);
+  if(a && b) return count(*a, *b);
+  return count(string_to_year(y1), string_to_year(y2));
+}
+
+uint64_t OrthodoxCalendar::impl::count_inperiod(const Date& d1, const Date& d2, DatePredicate predicate) const
+{
+  return count_inperiod__(d1, d2, [&](int k){ return get_orthyear_obj_(k)->days_where(predicate); }, false);
+}
+
+bool OrthodoxCalendar::impl::exists_inperiod(const Date& d1, const Date& d2, DatePredicate predicate) const
+{
+  return count_inperiod__(d1, d2, [&](int k){ return get_orthyear_obj_(k)->days_where(predicate); }, true) > 0;
+}
+
+void OrthodoxCalendar::impl::check_offsets(const int min_offset, const int max_offset)
+{
+  if(min_offset > max_offset || min_offset < -366 || max_offset > 366)
+    throw std::out_of_range("некорректный интервал смещений ["+std::to_string(min_offset)+", "
+                            +std::to_string(max_offset)+"]");
+}
+
+OrthYear::DayMask OrthodoxCalendar::impl::near_days(const int k, const DatePredicate& a, const DatePredicate& b,
+      const int min_offset, const int max_offset) const
+{ //дни a года цикла k, для которых в окне [день+min_offset, день+max_offset] есть день b.
+  //окно может выходить в соседние годы, поэтому дни b собираются за три года подряд;
+  //индекс в b_days - номер дня относительно 1 января года k, увеличенный на 366
+  const auto cur = get_orthyear_obj_(k);
+  const auto a_days = cur->days_where(a);
+  if(!a_days.any()) return {};
+  const auto prev = get_orthyear_obj_((k + PASCHAL_CYCLE - 1) % PASCHAL_CYCLE);
+  const auto next = get_orthyear_obj_((k + 1) % PASCHAL_CYCLE);
+  BitMask<3*366> b_days;
+  const int prev_base = 366 - prev->year_length();
+  const int next_base = 366 + cur->year_length();
+  prev->days_where(b).for_each([&](auto i){ b_days.set(prev_base + i); });
+  cur->days_where(b).for_each([&](auto i){ b_days.set(366 + i); });
+  next->days_where(b).for_each([&](auto i){ b_days.set(next_base + i); });
+  OrthYear::DayMask result;
+  a_days.for_each([&](int i){
+    const int found = b_days.find_next(366 + i + min_offset - 1);
+    if(found >= 0 && found <= 366 + i + max_offset) result.set(i);
+  });
+  return result;
+}
+
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::impl::cycle_dates_inperiod__(const Date& d1, const Date& d2,
+      CycleDays cycle_days) const
+{
+  if(!d1 || !d2) throw std::runtime_error(invalid_date);
+  auto [min, max] = std::minmax(d1, d2);
+  auto st = std::make_shared<CompactDatesView::state>();
+  st->cycle_days = std::move(cycle_days);
+  //границы, не представимые в виде CompactDate, приводят к исключению std::out_of_range;
+  //числа годов вычисляются по cjdn, поэтому допустим любой год, представимый в виде CompactDate
+  st->min = CompactDate(min).cjdn();
+  st->max = CompactDate(max).cjdn();
+  st->year = julian_year_of(st->min);
+  st->last_year = julian_year_of(st->max);
+  return CompactDatesView(std::move(st));
+}
+
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::impl::dates_inperiod_near(const Date& d1, const Date& d2,
+      DatePredicate a, DatePredicate b, const int min_offset, const int max_offset) const
+{
+  check_offsets(min_offset, max_offset);
+  return cycle_dates_inperiod__(d1, d2, [this, a = std::move(a), b = std::move(b), min_offset, max_offset](int k){
+    return near_days(k, a, b, min_offset, max_offset);
+  });
+}
+
+std::vector<CompactDate> OrthodoxCalendar::impl::get_alldates_inperiod_near(const Date& d1, const Date& d2,
+      DatePredicate a, DatePredicate b, const int min_offset, const int max_offset) const
+{
+  auto view = dates_inperiod_near(d1, d2, std::move(a), std::move(b), min_offset, max_offset);
+  std::vector<CompactDate> result;
+  for(auto d: view) result.push_back(d);
+  return result;
+}
+
+uint64_t OrthodoxCalendar::impl::count_inperiod_near(const Date& d1, const Date& d2, DatePredicate a,
+      DatePredicate b, const int min_offset, const int max_offset) const
+{
+  check_offsets(min_offset, max_offset);
+  return count_inperiod__(d1, d2, [&](int k){ return near_days(k, a, b, min_offset, max_offset); }, false);
+}
+
+template<typename DaysQuery>
+  Date OrthodoxCalendar::impl::adjacent_date__(const Date& from, DaysQuery query, const bool forward) const
+{ //за PASCHAL_CYCLE лет перебираются все варианты OrthYear, поэтому после них поиск бесполезен
+  if(!from) throw std::runtime_error(invalid_date);
+  const auto [y, m, d] = from.ymd(Julian);
+  auto loop = [&](auto j) -> Date {
+    for(int k=0; k<=PASCHAL_CYCLE && j >= MIN_YEAR_VALUE; ++k, forward ? ++j : --j) {
+      std::shared_ptr<const OrthYear> orthyear_obj;
+      if constexpr(std::is_same_v<decltype(j), big_int>) orthyear_obj = get_orthyear_obj(j.str());
+      else orthyear_obj = get_orthyear_obj(j);
+      const auto x = k==0 ? orthyear_obj->adjacent_day(query(*orthyear_obj), m, d, forward)
+                          : orthyear_obj->adjacent_day(query(*orthyear_obj), 0, 0, forward);
+      if(!x) continue;
+      if constexpr(std::is_same_v<decltype(j), big_int>) {
+        return Date(j.str(), x->first, x->second, Julian);
+      } else {
+        const int64_t c = julian_to_cjdn(j, x->first, x->second);
+        return c < MIN_CJDN_VALUE ? Date{} : Date(CompactDate::from_cjdn(c));
+      }
+    }
+    return {};
+  };
+  if(const auto j = fast_year(y); j) return loop(*j);
+  return loop(string_to_year(y));
+}
+
+Date OrthodoxCalendar::impl::adjacent_date_with(const Date& from, oxc_const property, const bool forward) const
+{
+  if(property_id(property) < 0) return {};
+  return adjacent_date__(from, [property](const OrthYear& y){ return y.days_withanyof({&property, 1}); }, forward);
+}
+
+Date OrthodoxCalendar::impl::adjacent_date_withanyof(const Date& from, std::span<oxc_const> properties,
+      const bool forward) const
+{
+  return adjacent_date__(from, [properties](const OrthYear& y){ return y.days_withanyof(properties); }, forward);
+}
+
+Date OrthodoxCalendar::impl::adjacent_date_withallof(const Date& from, std::span<oxc_const> properties,
+      const bool forward) const
+{
+  return adjacent_date__(from, [properties](const OrthYear& y){ return y.days_withallof(properties); }, forward);
+}
+
+Date OrthodoxCalendar::impl::adjacent_date_where(const Date& from, DatePredicate predicate, const bool forward) const
+{
+  return adjacent_date__(from, [&predicate](const OrthYear& y){ return y.days_where(predicate); }, forward);
+}
+
+bool OrthodoxCalendar::impl::set_winter_indent_weeks_1(const uint8_t w1)
+{
+  return set_indent_week_numbers_option(zimn_otstupka_n1, {w1});
+}
+
+bool OrthodoxCalendar::impl::set_winter_indent_weeks_2(const uint8_t w1, const uint8_t w2)
+{
+  return set_indent_week_numbers_option(zimn_otstupka_n2, {w1, w2});
+}
+
+bool OrthodoxCalendar::impl::set_winter_indent_weeks_3(const uint8_t w1, const uint8_t w2, const uint8_t w3)
+{
+  return set_indent_week_numbers_option(zimn_otstupka_n3, {w1, w2, w3});
+}
+
+bool OrthodoxCalendar::impl::set_winter_indent_weeks_4(const uint8_t w1, const uint8_t w2,
       const uint8_t w3, const uint8_t w4)
 {
-  return set_indent_week_numbers_option(zimn_otstupka_n4, {w1, w2, w3, w4});
+  return set_indent_week_numbers_option(zimn_otstupka_n4, {w1, w2, w3, w4});
+}
+
+bool OrthodoxCalendar::impl::set_winter_indent_weeks_5(const uint8_t w1, const uint8_t w2,
+      const uint8_t w3, const uint8_t w4, const uint8_t w5)
+{
+  return set_indent_week_numbers_option(zimn_otstupka_n5, {w1, w2, w3, w4, w5});
+}
+
+bool OrthodoxCalendar::impl::set_spring_indent_weeks(const uint8_t w1, const uint8_t w2)
+{
+  return set_indent_week_numbers_option(osen_otstupka, {w1, w2});
+}
+
+void OrthodoxCalendar::impl::set_spring_indent_apostol(const bool value)
+{
+  osen_otstupka_apostol = value;
+  update_options_fingerprint();
+}
+
+std::pair<std::vector<uint8_t>, bool> OrthodoxCalendar::impl::get_options() const
+{
+  const auto il = indent_options();
+  return {std::vector<uint8_t>(il.begin(), il.end()), osen_otstupka_apostol};
+}
+
+std::array<uint8_t,17> OrthodoxCalendar::impl::indent_options() const
+{
+  std::array<uint8_t,17> result;
+  auto it = result.begin();
+  it = std::copy(zimn_otstupka_n1.begin(), zimn_otstupka_n1.end(), it);
+  it = std::copy(zimn_otstupka_n2.begin(), zimn_otstupka_n2.end(), it);
+  it = std::copy(zimn_otstupka_n3.begin(), zimn_otstupka_n3.end(), it);
+  it = std::copy(zimn_otstupka_n4.begin(), zimn_otstupka_n4.end(), it);
+  it = std::copy(zimn_otstupka_n5.begin(), zimn_otstupka_n5.end(), it);
+  it = std::copy(osen_otstupka.begin(), osen_otstupka.end(), it);
+  return result;
+}
+
+void OrthodoxCalendar::impl::set_cache_limit(const std::size_t bytes)
+{
+  orthyear_cache->set_limit(bytes);
+}
+
+std::size_t OrthodoxCalendar::impl::cache_limit() const
+{
+  return orthyear_cache->get_limit();
+}
+
+std::size_t OrthodoxCalendar::impl::cache_memory_usage() const
+{
+  return orthyear_cache->memory_usage();
+}
+
+void OrthodoxCalendar::impl::set_shared_cache(const bool value)
+{
+  orthyear_cache.set_shared(value);
+}
+
+bool OrthodoxCalendar::impl::shared_cache() const
+{
+  return orthyear_cache.is_shared();
+}
+
+template<typename TYear>
+  void OrthodoxCalendar::impl::pin_year(const TYear& year)
+{
+  orthyear_cache->pin(cycle_year_of(year));
+}
+
+template<typename TYear>
+  void OrthodoxCalendar::impl::unpin_year(const TYear& year)
+{
+  orthyear_cache->unpin(cycle_year_of(year));
+}
+
+template<typename TYear>
+  std::pair<Month, Day> OrthodoxCalendar::impl::julian_pascha(const TYear& year) const
+{
+  return OrthYear::cycle_year_scalars(cycle_year_of(year)).pasha;
+}
+
+template<typename TYear>
+  Date OrthodoxCalendar::impl::pascha(const TYear& year, const CalendarFormat infmt) const
+{
+  if(infmt == Julian) {
+    const auto [m, d] = julian_pascha(year);
+    return make_date(year, m, d, Julian);
+  }
+  return get_date_with(year, oxc::pasha, infmt);
+}
+
+template<typename TYear>
+  int8_t OrthodoxCalendar::impl::winter_indent(const TYear& year) const
+{
+  return OrthYear::cycle_year_scalars(cycle_year_of(year)).winter_indent;
+}
+
+template<typename TYear>
+  int8_t OrthodoxCalendar::impl::spring_indent(const TYear& year) const
+{
+  return OrthYear::cycle_year_scalars(cycle_year_of(year)).spring_indent;
+}
+
+template<typename TYear>
+  int8_t OrthodoxCalendar::impl::apostol_post_length(const TYear& year) const
+{
+  return OrthYear::cycle_year_scalars(cycle_year_of(year)).apostol_post_length;
+}
+
+template<typename TYear, typename F>
+  void OrthodoxCalendar::impl::year_range__(const TYear& y1, const TYear& y2, F f)
+{ //вызывает f для границ диапазона лет по возрастанию: в int64_t, если это возможно, иначе в big_int
+  if constexpr(std::is_same_v<TYear, int64_t>) {
+    const int64_t a = check_year(y1), b = check_year(y2);
+    f(std::min(a, b), std::max(a, b));
+  } else {
+    const auto a = string_to_fast_int(y1);
+    const auto b = string_to_fast_int(y2);
+    if(a && b) {
+      year_range__(*a, *b, f);
+    } else {
+      const big_int x = string_to_year(y1), y = string_to_year(y2);
+      f(x < y ? x : y, x < y ? y : x);
+    }
+  }
+}
+
+template<typename TYear>
+  std::map<int8_t, uint64_t> OrthodoxCalendar::impl::year_histogram__(const TYear& y1, const TYear& y2,
+        CycleTable::Value value)
+{
+  std::map<int8_t, uint64_t> result;
+  CycleTable table(std::move(value));
+  year_range__(y1, y2, [&](const auto& a, const auto& b){
+    table.add(result, a, b, [](int v){ return static_cast<int8_t>(v); });
+  });
+  return result;
+}
+
+template<typename TYear>
+  std::map<std::pair<Month, Day>, uint64_t> OrthodoxCalendar::impl::pascha_histogram(const TYear& y1,
+        const TYear& y2, const CalendarFormat outfmt) const
+{ //значение таблицы - смещение даты пасхи от 1 марта (от 21 до 55); количества копятся по смещению даты
+  //от 1 марта в календаре outfmt (смещение 365 - 29 февраля)
+  constexpr int first_pascha = 21, last_pascha = 55;
+  CycleTable table([](int k) -> std::optional<int> {
+    const auto [m, d] = OrthYear::cycle_year_scalars(k).pasha;
+    return (m == 3 ? 0 : 31) + d - 1;
+  });
+  std::array<uint64_t, 366> counts{};
+  year_range__(y1, y2, [&](const auto& a, const auto& b){
+    using Integer = std::remove_cvref_t<decltype(a)>;
+    if(outfmt == Julian) {
+      table.add(counts, a, b, [](int v){ return v; });
+      return;
+    }
+    if constexpr(std::is_same_v<Integer, int64_t>) {
+      if(b > MAX_FAST_YEAR)
+        throw std::out_of_range("выход числа года '"+std::to_string(b)+"' за границу диапазона");
+      //разница между юлианским и гражданским календарями меняется только в конце февраля столетних годов,
+      //поэтому для дат пасхи она постоянна в пределах столетия
+      for(int64_t s = a; s <= b; ) {
+        const int64_t e = std::min(b, s / 100 * 100 + 99);
+        const int64_t delta = julian_year_start(s + 1) - civil_year_cjdn(s + 1, outfmt).first;
+        if(first_pascha + delta >= 0 && last_pascha + delta < 365) {
+          table.add(counts, s, e, [delta](int v){ return v + delta; });
+        } else { //дата пасхи уходит за февраль следующего года; день определяется для каждого года отдельно
+          for(int64_t y = s; y <= e; ++y) {
+            table.add(counts, y, y, [y, delta, outfmt](int v){
+              //смещение от 1 марта гражданского года y; отбрасываются целые годы от 1 марта до 1 марта
+              auto march_start = [&](const int64_t cy) {
+                return 365 * (cy - y) + leap_years_count(cy, outfmt) - leap_years_count(y, outfmt);
+              };
+              const int64_t x = v + delta;
+              int64_t cy = y + x / 366;
+              while(march_start(cy + 1) <= x) ++cy;
+              return x - march_start(cy);
+            });
+          }
+        }
+        s = e + 1;
+      }
+    } else {
+      throw std::out_of_range("выход числа года '"+b.str()+"' за границу диапазона");
+    }
+  });
+  std::map<std::pair<Month, Day>, uint64_t> result;
+  for(int i=0; i<static_cast<int>(counts.size()); ++i) {
+    if(counts[i]) result[i < 365 ? *date_from_march(i) : std::pair<Month, Day>{2, 29}] += counts[i];
+  }
+  return result;
+}
+
+template<typename TYear>
+  std::map<int8_t, uint64_t> OrthodoxCalendar::impl::winter_indent_histogram(const TYear& y1,
+        const TYear& y2) const
+{
+  return year_histogram__(y1, y2, [](int k) -> std::optional<int> {
+    return OrthYear::cycle_year_scalars(k).winter_indent;
+  });
+}
+
+template<typename TYear>
+  std::map<int8_t, uint64_t> OrthodoxCalendar::impl::spring_indent_histogram(const TYear& y1,
+        const TYear& y2) const
+{
+  return year_histogram__(y1, y2, [](int k) -> std::optional<int> {
+    return OrthYear::cycle_year_scalars(k).spring_indent;
+  });
+}
+
+template<typename TYear>
+  std::map<int8_t, uint64_t> OrthodoxCalendar::impl::apostol_post_length_histogram(const TYear& y1,
+        const TYear& y2) const
+{
+  return year_histogram__(y1, y2, [](int k) -> std::optional<int> {
+    return OrthYear::cycle_year_scalars(k).apostol_post_length;
+  });
+}
+
+template<typename TYear>
+  std::map<Weekday, uint64_t> OrthodoxCalendar::impl::weekday_histogram(const TYear& y1, const TYear& y2,
+        oxc_const property) const
+{ //день недели даты ст. ст. повторяется с периодом 28 лет, который укладывается в пасхальный цикл
+  const auto md = fixed_date_of(property);
+  if(!md) throw std::runtime_error("признак "+std::to_string(property)+" не является непереходящим");
+  return year_histogram__(y1, y2, [md](int k) -> std::optional<int> {
+    const int64_t y = int64_t{k} + PASCHAL_CYCLE;
+    if(md->second > month_length(md->first, y % 4 == 0)) return std::nullopt;
+    return (julian_to_cjdn(y, md->first, md->second) + 1) % 7;
+  });
+}
+
+auto OrthodoxCalendar::impl::date_glas(const Date& d) const
+{
+  return get_day_option(d, &DayEvaluator::glas);
+}
+
+auto OrthodoxCalendar::impl::date_glas(const int64_t y, const Month m, const Day d, const CalendarFormat infmt) const
+{
+  return get_day_option(y, m, d, infmt, &DayEvaluator::glas);
+}
+
+auto OrthodoxCalendar::impl::date_n50(const Date& d) const
+{
+  return get_day_option(d, &DayEvaluator::n50);
+}
+
+auto OrthodoxCalendar::impl::date_n50(const int64_t y, const Month m, const Day d, const CalendarFormat infmt) const
+{
+  return get_day_option(y, m, d, infmt, &DayEvaluator::n50);
+}
+
+std::vector<uint16_t> OrthodoxCalendar::impl::date_properties(const Date& date) const
+{
+  if(!date) return {};
+  if(auto x = get_date_option(date, &OrthYear::get_date_properties); x) return std::move(*x);
+  else return {};
+}
+
+std::vector<uint16_t> OrthodoxCalendar::impl::date_properties(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt) const
+{
+  if(auto x = get_date_option(y, m, d, infmt, &OrthYear::get_date_properties); x) return std::move(*x);
+  else return {};
+}
+
+OrthodoxCalendar::PropertyList OrthodoxCalendar::impl::make_property_list(const OrthYear::PropertyMask& markers)
+{
+  PropertyList result;
+  markers.for_each([&result](auto i){
+    if(result.count == result.CAPACITY) throw std::length_error("превышена емкость списка признаков дня");
+    result.items[result.count++] = properties_table[i].first;
+  });
+  return result;
+}
+
+OrthodoxCalendar::PropertyList OrthodoxCalendar::impl::date_property_list(const Date& date) const
+{
+  if(!date) return {};
+  return make_property_list(get_date_option(date, &OrthYear::get_date_property_mask));
+}
+
+OrthodoxCalendar::PropertyList OrthodoxCalendar::impl::date_property_list(const int64_t y, const Month m,
+      const Day d, const CalendarFormat infmt) const
+{
+  return make_property_list(get_date_option(y, m, d, infmt, &OrthYear::get_date_property_mask));
+}
+
+auto OrthodoxCalendar::impl::date_apostol(const Date& d) const
+{
+  return get_day_option(d, &DayEvaluator::apostol);
+}
+
+auto OrthodoxCalendar::impl::date_apostol(const int64_t y, const Month m, const Day d, const CalendarFormat infmt) const
+{
+  return get_day_option(y, m, d, infmt, &DayEvaluator::apostol);
+}
+
+auto OrthodoxCalendar::impl::date_evangelie(const Date& d) const
+{
+  return get_day_option(d, &DayEvaluator::evangelie);
+}
+
+auto OrthodoxCalendar::impl::date_evangelie(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt) const
+{
+  return get_day_option(y, m, d, infmt, &DayEvaluator::evangelie);
+}
+
+auto OrthodoxCalendar::impl::resurrect_evangelie(const Date& d) const
+{
+  return get_day_option(d, &DayEvaluator::resurrect_evangelie);
+}
+
+auto OrthodoxCalendar::impl::resurrect_evangelie(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt) const
+{
+  return get_day_option(y, m, d, infmt, &DayEvaluator::resurrect_evangelie);
+}
+
+OrthodoxCalendar::YearsInfo OrthodoxCalendar::impl::years_info(std::span<const int64_t> years)
+{ //годы проверяются заранее, поэтому основной цикл содержит только арифметику и запись в массивы
+  for(const auto y : years) check_year(y);
+  const auto n = years.size();
+  YearsInfo result;
+  result.pascha.resize(n);
+  result.winter_indent.resize(n);
+  result.spring_indent.resize(n);
+  result.apostol_post_length.resize(n);
+  for(std::size_t i=0; i<n; ++i) {
+    const auto x = OrthYear::cycle_year_scalars(static_cast<int>(years[i] % PASCHAL_CYCLE));
+    result.pascha[i] = x.pasha;
+    result.winter_indent[i] = x.winter_indent;
+    result.spring_indent[i] = x.spring_indent;
+    result.apostol_post_length[i] = x.apostol_post_length;
+  }
+  return result;
+}
+
+OrthodoxCalendar::DatesInfo OrthodoxCalendar::impl::dates_info(std::span<const CompactDate> dates,
+      const unsigned fields, const Executor* executor) const
+{ //индексы дат раскладываются по годам пасхального цикла (сортировка подсчетом), затем каждая группа
+  //обрабатывается с одним объектом OrthYear; executor == nullptr - последовательная обработка
+  DatesInfo result;
+  const size_t n = dates.size();
+  if(fields & info_properties) result.properties.resize(n);
+  if(fields & info_glas) result.glas.resize(n);
+  if(fields & info_n50) result.n50.resize(n);
+  if(fields & info_apostol) result.apostol.resize(n);
+  if(fields & info_evangelie) result.evangelie.resize(n);
+  if(fields & info_resurrect_evangelie) result.resurrect_evangelie.resize(n);
+  auto fill = [&](const OrthYear& orthyear, size_t i, int8_t month, int8_t day){
+    if(fields & info_properties) {
+      if(auto x = orthyear.get_date_properties(month, day); x) result.properties[i] = std::move(*x);
+    }
+    if(fields & info_glas) result.glas[i] = orthyear.get_date_glas(month, day);
+    if(fields & info_n50) result.n50[i] = orthyear.get_date_n50(month, day);
+    if(fields & info_apostol) result.apostol[i] = orthyear.get_date_apostol(month, day);
+    if(fields & info_evangelie) result.evangelie[i] = orthyear.get_date_evangelie(month, day);
+    if(fields & info_resurrect_evangelie) result.resurrect_evangelie[i] = orthyear.get_resurrect_evangelie(month, day);
+  };
+  std::vector<int16_t> cycle(n), day_index(n);
+  std::array<size_t, PASCHAL_CYCLE + 1> offsets{};
+  for(size_t i=0; i<n; ++i) {
+    if(dates[i].empty()) throw std::runtime_error(invalid_date);
+    const int64_t c = dates[i].cjdn();
+    if(c > MAX_FAST_CJDN) { //редкий случай: год вычисляется через big_int
+      cycle[i] = -1;
+      const Date date(dates[i]);
+      fill(*get_orthyear_obj(date.year(Julian)), i, date.month(Julian), date.day(Julian));
+      continue;
+    }
+    const int64_t j = julian_year_of(c);
+    cycle[i] = static_cast<int16_t>(j % PASCHAL_CYCLE);
+    day_index[i] = static_cast<int16_t>(c - julian_year_start(j));
+    ++offsets[cycle[i] + 1];
+  }
+  for(int k=0; k<PASCHAL_CYCLE; ++k) offsets[k+1] += offsets[k];
+  std::vector<size_t> order(offsets[PASCHAL_CYCLE]);
+  {
+    auto pos = offsets;
+    for(size_t i=0; i<n; ++i) if(cycle[i] >= 0) order[pos[cycle[i]]++] = i;
+  }
+  std::vector<int> groups;
+  for(int k=0; k<PASCHAL_CYCLE; ++k) if(offsets[k] != offsets[k+1]) groups.push_back(k);
+  auto task = [&](size_t g){
+    const int k = groups[g];
+    const auto orthyear_obj = get_orthyear_obj_(k);
+    for(size_t p = offsets[k]; p < offsets[k+1]; ++p) {
+      const size_t i = order[p];
+      const auto [month, day] = orthyear_obj->day_date(day_index[i]);
+      fill(*orthyear_obj, i, month, day);
+    }
+  };
+  if(executor) {
+    run_parallel(*executor, groups.size(), task);
+  } else {
+    for(size_t g=0; g<groups.size(); ++g) task(g);
+  }
+  return result;
+}
+
+bool OrthodoxCalendar::impl::is_date_of(const Date& d, oxc_const property) const
+{
+  if(!d) return false;
+  return get_date_option(d, &OrthYear::is_date_of, property);
+}
+
+bool OrthodoxCalendar::impl::is_date_of(const int64_t y, const Month m, const Day d, oxc_const property,
+      const CalendarFormat infmt) const
+{
+  return get_date_option(y, m, d, infmt, &OrthYear::is_date_of, property);
+}
+
+template<typename TYear>
+  Date OrthodoxCalendar::impl::get_date_with(const TYear& year, oxc_const property,
+        const CalendarFormat infmt) const
+{
+  if(auto md = fixed_date_of(property); md) {
+    auto x = fixed_dates__<Date>(year, *md, infmt, true);
+    return x.empty() ? Date{} : std::move(x.front());
+  }
+  return get_date__(year, property, infmt, &OrthYear::get_date_with, &impl::get_date_inperiod_with);
+}
+
+Date OrthodoxCalendar::impl::get_date_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const
+{
+  if(auto md = fixed_date_of(property); md) {
+    auto x = fixed_dates_inperiod__<Date>(d1, d2, *md, true);
+    return x.empty() ? Date{} : std::move(x.front());
+  }
+  return get_date_inperiod__(d1, d2, property, &OrthYear::get_date_with);
+}
+
+Date OrthodoxCalendar::impl::get_date_inperiod_with(const Date& d1, const Date& d2, oxc_const property,
+      const Executor& executor) const
+{
+  if(fixed_date_of(property)) return get_date_inperiod_with(d1, d2, property);
+  return get_date_inperiod__(d1, d2, property, &OrthYear::get_date_with, executor);
+}
+
+template<typename TYear>
+  std::vector<Date> OrthodoxCalendar::impl::get_alldates_with(const TYear& year, oxc_const property,
+        const CalendarFormat infmt) const
+{
+  if(auto md = fixed_date_of(property); md) return fixed_dates__<Date>(year, *md, infmt, false);
+  return get_alldates__<Date>(year, property, infmt, &OrthYear::get_alldates_with,
+                                                             &impl::get_alldates_inperiod_with);
+}
+
+std::vector<Date> OrthodoxCalendar::impl::get_alldates_inperiod_with(const Date& d1, const Date& d2,
+      oxc_const property) const
+{
+  if(auto md = fixed_date_of(property); md) return fixed_dates_inperiod__<Date>(d1, d2, *md, false);
+  return get_alldates_inperiod__<Date>(d1, d2, property, &OrthYear::get_alldates_with);
+}
+
+std::vector<Date> OrthodoxCalendar::impl::get_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property,
+      const Executor& executor) const
+{
+  if(auto md = fixed_date_of(property); md) return fixed_dates_inperiod__<Date>(d1, d2, *md, false);
+  return get_alldates_inperiod__<Date>(d1, d2, property, &OrthYear::get_alldates_with, executor);
+}
+
+template<typename TYear>
+  std::vector<CompactDate> OrthodoxCalendar::impl::get_compact_alldates_with(const TYear& year,
+        oxc_const property, const CalendarFormat infmt) const
+{
+  if(auto md = fixed_date_of(property); md) return fixed_dates__<CompactDate>(year, *md, infmt, false);
+  return get_alldates__<CompactDate>(year, property, infmt, &OrthYear::get_alldates_with,
+                                                             &impl::get_compact_alldates_inperiod_with);
+}
+
+std::vector<CompactDate> OrthodoxCalendar::impl::get_compact_alldates_inperiod_with(const Date& d1, const Date& d2,
+      oxc_const property) const
+{
+  if(auto md = fixed_date_of(property); md) return fixed_dates_inperiod__<CompactDate>(d1, d2, *md, false);
+  return get_alldates_inperiod__<CompactDate>(d1, d2, property, &OrthYear::get_alldates_with);
+}
+
+std::vector<CompactDate> OrthodoxCalendar::impl::get_compact_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property,
+      const Executor& executor) const
+{
+  if(auto md = fixed_date_of(property); md) return fixed_dates_inperiod__<CompactDate>(d1, d2, *md, false);
+  return get_alldates_inperiod__<CompactDate>(d1, d2, property, &OrthYear::get_alldates_with, executor);
+}
+
+template<typename TYear>
+  Date OrthodoxCalendar::impl::get_date_withanyof(const TYear& year, std::span<oxc_const> properties,
+        const CalendarFormat infmt) const
+{
+  return get_date__(year, properties, infmt, &OrthYear::get_date_withanyof, &impl::get_date_inperiod_withanyof);
+}
+
+Date OrthodoxCalendar::impl::get_date_inperiod_withanyof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
+{
+  return get_date_inperiod__(d1, d2, properties, &OrthYear::get_date_withanyof);
+}
+
+Date OrthodoxCalendar::impl::get_date_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+      const Executor& executor) const
+{
+  return get_date_inperiod__(d1, d2, properties, &OrthYear::get_date_withanyof, executor);
+}
+
+template<typename TYear>
+  Date OrthodoxCalendar::impl::get_date_withallof(const TYear& year, std::span<oxc_const> properties,
+        const CalendarFormat infmt) const
+{
+  return get_date__(year, properties, infmt, &OrthYear::get_date_withallof, &impl::get_date_inperiod_withallof);
+}
+
+Date OrthodoxCalendar::impl::get_date_inperiod_withallof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
+{
+  return get_date_inperiod__(d1, d2, properties, &OrthYear::get_date_withallof);
+}
+
+Date OrthodoxCalendar::impl::get_date_inperiod_withallof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+      const Executor& executor) const
+{
+  return get_date_inperiod__(d1, d2, properties, &OrthYear::get_date_withallof, executor);
+}
+
+template<typename TYear>
+  std::vector<Date> OrthodoxCalendar::impl::get_alldates_withanyof(const TYear& year,
+        std::span<oxc_const> properties, const CalendarFormat infmt) const
+{
+  return get_alldates__<Date>(year, properties, infmt, &OrthYear::get_alldates_withanyof,
+                                                             &impl::get_alldates_inperiod_withanyof);
+}
+
+std::vector<Date> OrthodoxCalendar::impl::get_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
+{
+  return get_alldates_inperiod__<Date>(d1, d2, properties, &OrthYear::get_alldates_withanyof);
+}
+
+std::vector<Date> OrthodoxCalendar::impl::get_alldates_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+      const Executor& executor) const
+{
+  return get_alldates_inperiod__<Date>(d1, d2, properties, &OrthYear::get_alldates_withanyof, executor);
+}
+
+template<typename TYear>
+  std::vector<CompactDate> OrthodoxCalendar::impl::get_compact_alldates_withanyof(const TYear& year,
+        std::span<oxc_const> properties, const CalendarFormat infmt) const
+{
+  return get_alldates__<CompactDate>(year, properties, infmt, &OrthYear::get_alldates_withanyof,
+                                                             &impl::get_compact_alldates_inperiod_withanyof);
+}
+
+std::vector<CompactDate> OrthodoxCalendar::impl::get_compact_alldates_inperiod_withanyof(const Date& d1,
+      const Date& d2, std::span<oxc_const> properties) const
+{
+  return get_alldates_inperiod__<CompactDate>(d1, d2, properties, &OrthYear::get_alldates_withanyof);
+}
+
+std::vector<CompactDate> OrthodoxCalendar::impl::get_compact_alldates_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+      const Executor& executor) const
+{
+  return get_alldates_inperiod__<CompactDate>(d1, d2, properties, &OrthYear::get_alldates_withanyof, executor);
+}
+
+std::string OrthodoxCalendar::impl::get_description_for_date(const Date& d, std::string& datefmt) const
+{
+  if(!d) return {};
+  std::string result, buf;
+  auto p = date_properties(d);
+  for(const auto i: p) if(i < 3001) buf += property_title(i) + ' ';
+  if(auto x = std::find(p.begin(), p.end(), oxc::post_petr); x!=p.end())
+        buf += property_title(oxc::post_petr) + ". ";
+  if(auto x = std::find(p.begin(), p.end(), oxc::post_usp); x!=p.end())
+        buf += property_title(oxc::post_usp) + ". ";
+  if(auto x = std::find(p.begin(), p.end(), oxc::post_rojd); x!=p.end())
+        buf += property_title(oxc::post_rojd) + ". ";
+  result = d.format(datefmt) + ' ' + buf;
+  while(!result.empty() && result.front()==' ') result.erase(result.begin());
+  while(!result.empty() && result.back()==' ') result.pop_back();
+  return result;
+}
+
+template<typename TDate>
+  std::string OrthodoxCalendar::impl::get_description_for_dates(std::span<const TDate> days, std::string& datefmt,
+        const std::string& separator) const
+{
+  std::string res;
+  for(auto it=days.begin(); it!=days.end(); ++it){
+    if(auto s = get_description_for_date(*it, datefmt); !s.empty()){
+      if(it!=days.begin()) res += separator;
+      res += s;
+    }
+  }
+  return res;
+}
+
+/*----------------------------------------------*/
+/*          class OrthodoxCalendar              */
+/*----------------------------------------------*/
+
+OrthodoxCalendar::OrthodoxCalendar() : pimpl(new OrthodoxCalendar::impl())
+{
+}
+
+OrthodoxCalendar::~OrthodoxCalendar() = default	;
+
+OrthodoxCalendar::OrthodoxCalendar(OrthodoxCalendar&&) noexcept = default;
+
+OrthodoxCalendar& OrthodoxCalendar::operator=(OrthodoxCalendar&&) noexcept = default;
+
+OrthodoxCalendar::OrthodoxCalendar(const OrthodoxCalendar& other) : pimpl(new OrthodoxCalendar::impl(*other.pimpl))
+{
+}
+
+OrthodoxCalendar& OrthodoxCalendar::operator=(const OrthodoxCalendar& other)
+{
+  if(this != &other) pimpl.reset(new OrthodoxCalendar::impl(*other.pimpl));
+  return *this;
+}
+
+bool OrthodoxCalendar::set_winter_indent_weeks_1(const uint8_t w1)
+{
+  return pimpl->set_winter_indent_weeks_1(w1);
+}
+
+bool OrthodoxCalendar::set_winter_indent_weeks_2(const uint8_t w1, const uint8_t w2)
+{
+  return pimpl->set_winter_indent_weeks_2(w1, w2);
+}
+
+bool OrthodoxCalendar::set_winter_indent_weeks_3(const uint8_t w1, const uint8_t w2, const uint8_t w3)
+{
+  return pimpl->set_winter_indent_weeks_3(w1, w2, w3);
+}
+
+bool OrthodoxCalendar::set_winter_indent_weeks_4(const uint8_t w1, const uint8_t w2, const uint8_t w3, const uint8_t w4)
+{
+  return pimpl->set_winter_indent_weeks_4(w1, w2, w3, w4);
+}
+
+bool OrthodoxCalendar::set_winter_indent_weeks_5(const uint8_t w1, const uint8_t w2, const uint8_t w3,
+      const uint8_t w4, const uint8_t w5)
+{
+  return pimpl->set_winter_indent_weeks_5(w1, w2, w3, w4, w5);
+}
+
+bool OrthodoxCalendar::set_spring_indent_weeks(const uint8_t w1, const uint8_t w2)
+{
+  return pimpl->set_spring_indent_weeks(w1, w2);
+}
+
+void OrthodoxCalendar::set_spring_indent_apostol(const bool value)
+{
+  return pimpl->set_spring_indent_apostol(value);
+}
+
+//постоянный набор потоков исполнителя thread_executor. вызывающий поток работает вместе с threads-1 потоками
+//набора; номера задач раздаются из общего счетчика. набор выполняет один вызов за раз: вызов, пришедший
+//во время выполнения другого (в т.ч. из задачи), выполняется целиком в вызывающем потоке
+class ThreadPool {
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  std::mutex call_mutex;
+  const std::function<void(std::size_t)>* task{};
+  std::size_t count{};
+  std::atomic<std::size_t> next{};
+  std::size_t active{};//потоки набора, еще не закончившие текущий вызов
+  uint64_t generation{};//номер вызова
+  bool stop{};
+  std::vector<std::jthread> workers;
+
+  void work()
+  {
+    for(auto i = next++; i < count; i = next++) (*task)(i);
+  }
+  void loop()
+  {
+    uint64_t seen{};
+    while(true) {
+      {
+        std::unique_lock lock(mutex);
+        wake.wait(lock, [&]{ return stop || generation != seen; });
+        if(stop) return;
+        seen = generation;
+      }
+      work();
+      std::lock_guard lock(mutex);
+      if(--active == 0) done.notify_one();
+    }
+  }
+
+public:
+  explicit ThreadPool(unsigned threads)
+  {
+    for(unsigned k = 1; k < threads; ++k) workers.emplace_back([this]{ loop(); });
+  }
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard lock(mutex);
+      stop = true;
+    }
+    wake.notify_all();
+  }
+  void run(std::size_t n, const std::function<void(std::size_t)>& f)
+  {
+    std::unique_lock call(call_mutex, std::try_to_lock);
+    if(!call || workers.empty() || n < 2) {
+      for(std::size_t i = 0; i < n; ++i) f(i);
+      return;
+    }
+    {
+      std::lock_guard lock(mutex);
+      task = &f;
+      count = n;
+      next = 0;
+      active = workers.size();
+      ++generation;
+    }
+    wake.notify_all();
+    work();
+    std::unique_lock lock(mutex);
+    done.wait(lock, [&]{ return active == 0; });
+    task = nullptr;
+  }
+};
+
+/*static*/OrthodoxCalendar::Executor OrthodoxCalendar::thread_executor(unsigned threads)
+{
+  if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  return [pool = std::make_shared<ThreadPool>(threads)](std::size_t n, const std::function<void(std::size_t)>& task){
+    pool->run(n, task);
+  };
+}
+
+std::pair<std::vector<uint8_t>, bool> OrthodoxCalendar::get_options() const
+{
+  return pimpl->get_options();
+}
+
+void OrthodoxCalendar::set_cache_limit(const std::size_t bytes)
+{
+  pimpl->set_cache_limit(bytes);
+}
+
+std::size_t OrthodoxCalendar::cache_limit() const
+{
+  return pimpl->cache_limit();
+}
+
+std::size_t OrthodoxCalendar::cache_memory_usage() const
+{
+  return pimpl->cache_memory_usage();
+}
+
+void OrthodoxCalendar::set_shared_cache(const bool value)
+{
+  pimpl->set_shared_cache(value);
+}
+
+bool OrthodoxCalendar::shared_cache() const
+{
+  return pimpl->shared_cache();
+}
+
+void OrthodoxCalendar::pin_year(const Year& year)
+{
+  pimpl->pin_year(year);
+}
+
+void OrthodoxCalendar::pin_year(const int64_t year)
+{
+  pimpl->pin_year(year);
+}
+
+void OrthodoxCalendar::unpin_year(const Year& year)
+{
+  pimpl->unpin_year(year);
+}
+
+void OrthodoxCalendar::unpin_year(const int64_t year)
+{
+  pimpl->unpin_year(year);
+}
+
+std::pair<Month, Day> OrthodoxCalendar::julian_pascha(const Year& year) const
+{
+  return pimpl->julian_pascha(year);
+}
+
+std::pair<Month, Day> OrthodoxCalendar::julian_pascha(const int64_t year) const
+{
+  return pimpl->julian_pascha(year);
+}
+
+Date OrthodoxCalendar::pascha(const Year& year, const CalendarFormat infmt) const
+{
+  return pimpl->pascha(year, infmt);
+}
+
+Date OrthodoxCalendar::pascha(const int64_t year, const CalendarFormat infmt) const
+{
+  return pimpl->pascha(year, infmt);
+}
+
+int8_t OrthodoxCalendar::winter_indent(const Year& year) const
+{
+  return pimpl->winter_indent(year);
+}
+
+int8_t OrthodoxCalendar::winter_indent(const int64_t year) const
+{
+  return pimpl->winter_indent(year);
+}
+
+int8_t OrthodoxCalendar::spring_indent(const Year& year) const
+{
+  return pimpl->spring_indent(year);
+}
+
+int8_t OrthodoxCalendar::spring_indent(const int64_t year) const
+{
+  return pimpl->spring_indent(year);
+}
+
+int8_t OrthodoxCalendar::apostol_post_length(const Year& year) const
+{
+  return pimpl->apostol_post_length(year);
+}
+
+int8_t OrthodoxCalendar::apostol_post_length(const int64_t year) const
+{
+  return pimpl->apostol_post_length(year);
+}
+
+OrthodoxCalendar::YearsInfo OrthodoxCalendar::years_info(std::span<const int64_t> years) const
+{
+  return impl::years_info(years);
+}
+
+std::map<std::pair<Month, Day>, uint64_t> OrthodoxCalendar::pascha_histogram(const Year& y1, const Year& y2,
+      const CalendarFormat outfmt) const
+{
+  return pimpl->pascha_histogram(y1, y2, outfmt);
+}
+
+std::map<std::pair<Month, Day>, uint64_t> OrthodoxCalendar::pascha_histogram(const int64_t y1, const int64_t y2,
+      const CalendarFormat outfmt) const
+{
+  return pimpl->pascha_histogram(y1, y2, outfmt);
+}
+
+std::map<int8_t, uint64_t> OrthodoxCalendar::winter_indent_histogram(const Year& y1, const Year& y2) const
+{
+  return pimpl->winter_indent_histogram(y1, y2);
+}
+
+std::map<int8_t, uint64_t> OrthodoxCalendar::winter_indent_histogram(const int64_t y1, const int64_t y2) const
+{
+  return pimpl->winter_indent_histogram(y1, y2);
+}
+
+std::map<int8_t, uint64_t> OrthodoxCalendar::spring_indent_histogram(const Year& y1, const Year& y2) const
+{
+  return pimpl->spring_indent_histogram(y1, y2);
+}
+
+std::map<int8_t, uint64_t> OrthodoxCalendar::spring_indent_histogram(const int64_t y1, const int64_t y2) const
+{
+  return pimpl->spring_indent_histogram(y1, y2);
+}
+
+std::map<int8_t, uint64_t> OrthodoxCalendar::apostol_post_length_histogram(const Year& y1, const Year& y2) const
+{
+  return pimpl->apostol_post_length_histogram(y1, y2);
+}
+
+std::map<int8_t, uint64_t> OrthodoxCalendar::apostol_post_length_histogram(const int64_t y1,
+      const int64_t y2) const
+{
+  return pimpl->apostol_post_length_histogram(y1, y2);
+}
+
+std::map<Weekday, uint64_t> OrthodoxCalendar::weekday_histogram(const Year& y1, const Year& y2,
+      oxc_const property) const
+{
+  return pimpl->weekday_histogram(y1, y2, property);
+}
+
+std::map<Weekday, uint64_t> OrthodoxCalendar::weekday_histogram(const int64_t y1, const int64_t y2,
+      oxc_const property) const
+{
+  return pimpl->weekday_histogram(y1, y2, property);
+}
+
+int8_t OrthodoxCalendar::date_glas(const Year& y, const Month m, const Day d, const CalendarFormat infmt) const
+{
+  return pimpl->date_glas(Date(y, m, d, infmt));
+}
+
+int8_t OrthodoxCalendar::date_glas(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt) const
+{
+  return pimpl->date_glas(y, m, d, infmt);
+}
+
+int8_t OrthodoxCalendar::date_glas(const Date& d) const
+{
+  return pimpl->date_glas(d);
+}
+
+int8_t OrthodoxCalendar::date_n50(const Year& y, const Month m, const Day d, const CalendarFormat infmt) const
+{
+  return pimpl->date_n50(Date(y, m, d, infmt));
+}
+
+int8_t OrthodoxCalendar::date_n50(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt) const
+{
+  return pimpl->date_n50(y, m, d, infmt);
+}
+
+int8_t OrthodoxCalendar::date_n50(const Date& d) const
+{
+  return pimpl->date_n50(d);
+}
+
+std::vector<uint16_t> OrthodoxCalendar::date_properties(const Year& y, const Month m, const Day d,
+      const CalendarFormat infmt) const
+{
+  return pimpl->date_properties(Date(y, m, d, infmt));
 }
 
-bool OrthodoxCalendar::impl::set_winter_indent_weeks_5(const uint8_t w1, const uint8_t w2,
-      const uint8_t w3, const uint8_t w4, const uint8_t w5)
+std::vector<uint16_t> OrthodoxCalendar::date_properties(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt) const
 {
-  return set_indent_week_numbers_option(zimn_otstupka_n5, {w1, w2, w3, w4, w5});
+  return pimpl->date_properties(y, m, d, infmt);
 }
 
-bool OrthodoxCalendar::impl::set_spring_indent_weeks(const uint8_t w1, const uint8_t w2)
+std::vector<uint16_t> OrthodoxCalendar::date_properties(const Date& d) const
 {
-  return set_indent_week_numbers_option(osen_otstupka, {w1, w2});
+  return pimpl->date_properties(d);
 }
 
-void OrthodoxCalendar::impl::set_spring_indent_apostol(const bool value)
+OrthodoxCalendar::PropertyList OrthodoxCalendar::date_property_list(const Year& y, const Month m, const Day d,
+      const CalendarFormat infmt) const
 {
-  osen_otstupka_apostol = value;
+  return pimpl->date_property_list(Date(y, m, d, infmt));
 }
 
-std::pair<std::vector<uint8_t>, bool> OrthodoxCalendar::impl::get_options() const
+OrthodoxCalendar::PropertyList OrthodoxCalendar::date_property_list(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt) const
 {
-  std::vector<uint8_t> first_res(17, 0);
-  auto it = first_res.begin();
-  it = std::copy(zimn_otstupka_n1.begin(), zimn_otstupka_n1.end(), it);
-  it = std::copy(zimn_otstupka_n2.begin(), zimn_otstupka_n2.end(), it);
-  it = std::copy(zimn_otstupka_n3.begin(), zimn_otstupka_n3.end(), it);
-  it = std::copy(zimn_otstupka_n4.begin(), zimn_otstupka_n4.end(), it);
-  it = std::copy(zimn_otstupka_n5.begin(), zimn_otstupka_n5.end(), it);
-  it = std::copy(osen_otstupka.begin(), osen_otstupka.end(), it);
-  return {first_res, osen_otstupka_apostol};
+  return pimpl->date_property_list(y, m, d, infmt);
 }
 
-std::pair<Month, Day> OrthodoxCalendar::impl::julian_pascha(const Year& year) const
+OrthodoxCalendar::PropertyList OrthodoxCalendar::date_property_list(const Date& d) const
 {
-  const auto& orthyear_obj = get_orthyear_obj(year);
-  return orthyear_obj.get_date_with(oxc::pasha).value();
+  return pimpl->date_property_list(d);
 }
 
-Date OrthodoxCalendar::impl::pascha(const Year& year, const CalendarFormat infmt) const
+ApEvReads OrthodoxCalendar::date_apostol(const Year& y, const Month m, const Day d, const CalendarFormat infmt) const
 {
-  return get_date_with(year, oxc::pasha, infmt);
+  return pimpl->date_apostol(Date(y, m, d, infmt));
 }
 
-int8_t OrthodoxCalendar::impl::winter_indent(const Year& year) const
+ApEvReads OrthodoxCalendar::date_apostol(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt) const
 {
-  const auto& orthyear_obj = get_orthyear_obj(year);
-  return orthyear_obj.get_winter_indent() ;
+  return pimpl->date_apostol(y, m, d, infmt);
 }
 
-int8_t OrthodoxCalendar::impl::spring_indent(const Year& year) const
+ApEvReads OrthodoxCalendar::date_apostol(const Date& d) const
 {
-  const auto& orthyear_obj = get_orthyear_obj(year);
-  return orthyear_obj.get_spring_indent() ;
+  return pimpl->date_apostol(d);
 }
 
-int8_t OrthodoxCalendar::impl::apostol_post_length(const Year& year) const
+ApEvReads OrthodoxCalendar::date_evangelie(const Year& y, const Month m, const Day d, const CalendarFormat infmt) const
 {
-  auto dec_date_by_one = [](Month& m, Day& d, const bool leap)
-  {
-    d--;
-    if(d < 1) {
-      m--;
-      if(m<1) m = 12;
-      d += month_length(m, leap);
-    }
-  };
-  const auto& orthyear_obj = get_orthyear_obj(year);
-  auto d1 = orthyear_obj.get_date_with(oxc::ned1_po50);
-  auto d2 = orthyear_obj.get_date_with(oxc::m6d29);
-  if(d1 && d2) {
-    const bool b = is_leap_year(year, Julian);
-    int8_t days_count{};
-    do {
-      dec_date_by_one(d2->first, d2->second, b);
-      days_count++;
-    } while(*d1 != *d2);
-    return days_count-1;
-  }
-  return 0;
+  return pimpl->date_evangelie(Date(y, m, d, infmt));
 }
 
-auto OrthodoxCalendar::impl::date_glas(const Date& d) const
+ApEvReads OrthodoxCalendar::date_evangelie(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt) const
 {
-  return get_date_option(d, &OrthYear::get_date_glas);
+  return pimpl->date_evangelie(y, m, d, infmt);
 }
 
-auto OrthodoxCalendar::impl::date_n50(const Date& d) const
+ApEvReads OrthodoxCalendar::date_evangelie(const Date& d) const
 {
-  return get_date_option(d, &OrthYear::get_date_n50);
+  return pimpl->date_evangelie(d);
 }
 
-std::vector<uint16_t> OrthodoxCalendar::impl::date_properties(const Date& date) const
+ApEvReads OrthodoxCalendar::resurrect_evangelie(const Year& y, const Month m, const Day d,
+      const CalendarFormat infmt) const
 {
-  if(!date) return {};
-  const auto& orthyear_obj = get_orthyear_obj(date.year(Julian));
-  if(auto x = orthyear_obj.get_date_properties(date.month(Julian), date.day(Julian)); x) return x.value();
-  else return {};
+  return pimpl->resurrect_evangelie(Date(y, m, d, infmt));
 }
 
-auto OrthodoxCalendar::impl::date_apostol(const Date& d) const
+ApEvReads OrthodoxCalendar::resurrect_evangelie(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt) const
 {
-  return get_date_option(d, &OrthYear::get_date_apostol);
+  return pimpl->resurrect_evangelie(y, m, d, infmt);
 }
 
-auto OrthodoxCalendar::impl::date_evangelie(const Date& d) const
+ApEvReads OrthodoxCalendar::resurrect_evangelie(const Date& d) const
 {
-  return get_date_option(d, &OrthYear::get_date_evangelie);
+  return pimpl->resurrect_evangelie(d);
 }
 
-auto OrthodoxCalendar::impl::resurrect_evangelie(const Date& d) const
+OrthodoxCalendar::DatesInfo OrthodoxCalendar::dates_info(std::span<const CompactDate> dates,
+      const unsigned fields) const
 {
-  return get_date_option(d, &OrthYear::get_resurrect_evangelie);
+  return pimpl->dates_info(dates, fields, nullptr);
 }
 
-bool OrthodoxCalendar::impl::is_date_of(const Date& d, oxc_const property) const
+OrthodoxCalendar::DatesInfo OrthodoxCalendar::dates_info(std::span<const CompactDate> dates,
+      const unsigned fields, const Executor& executor) const
 {
-  if(auto x = date_properties(d); !x.empty()) {
-    return std::any_of( x.begin(), x.end(), [property](auto i){ return i==property; } );
-  }
-  return false;
+  return pimpl->dates_info(dates, fields, &executor);
 }
 
-Date OrthodoxCalendar::impl::get_date_with(const Year& year, oxc_const property,
+bool OrthodoxCalendar::is_date_of(const Year& y, const Month m, const Day d, oxc_const property,
       const CalendarFormat infmt) const
 {
-  return get_date__(year, property, infmt, &OrthYear::get_date_with, &impl::get_date_inperiod_with);
+  return pimpl->is_date_of(Date(y, m, d, infmt), property);
 }
 
-Date OrthodoxCalendar::impl::get_date_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const
+bool OrthodoxCalendar::is_date_of(const int64_t y, const Month m, const Day d, oxc_const property,
+      const CalendarFormat infmt) const
 {
-  return get_date_inperiod__(d1, d2, property, &OrthYear::get_date_with);
+  return pimpl->is_date_of(y, m, d, property, infmt);
 }
 
-std::vector<Date> OrthodoxCalendar::impl::get_alldates_with(const Year& year, oxc_const property,
-      const CalendarFormat infmt) const
+bool OrthodoxCalendar::is_date_of(const Date& d, oxc_const property) const
 {
-  return get_alldates__(year, property, infmt, &OrthYear::get_alldates_with, &impl::get_alldates_inperiod_with);
+  return pimpl->is_date_of(d, property);
 }
 
-std::vector<Date> OrthodoxCalendar::impl::get_alldates_inperiod_with(const Date& d1, const Date& d2,
-      oxc_const property) const
+Date OrthodoxCalendar::get_date_with(const Year& year, oxc_const property, const CalendarFormat infmt) const
 {
-  return get_alldates_inperiod__(d1, d2, property, &OrthYear::get_alldates_with);
+  return pimpl->get_date_with(year, property, infmt);
 }
 
-Date OrthodoxCalendar::impl::get_date_withanyof(const Year& year, std::span<oxc_const> properties,
+Date OrthodoxCalendar::get_date_with(const int64_t year, oxc_const property,
       const CalendarFormat infmt) const
 {
-  return get_date__(year, properties, infmt, &OrthYear::get_date_withanyof, &impl::get_date_inperiod_withanyof);
+  return pimpl->get_date_with(year, property, infmt);
 }
 
-Date OrthodoxCalendar::impl::get_date_inperiod_withanyof(const Date& d1, const Date& d2,
-      std::span<oxc_const> properties) const
+Date OrthodoxCalendar::get_date_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const
 {
-  return get_date_inperiod__(d1, d2, properties, &OrthYear::get_date_withanyof);
+  return pimpl->get_date_inperiod_with(d1, d2, property);
 }
 
-Date OrthodoxCalendar::impl::get_date_withallof(const Year& year, std::span<oxc_const> properties,
-      const CalendarFormat infmt) const
+Date OrthodoxCalendar::get_date_inperiod_with(const Date& d1, const Date& d2, oxc_const property,
+      const Executor& executor) const
 {
-  return get_date__(year, properties, infmt, &OrthYear::get_date_withallof, &impl::get_date_inperiod_withallof);
+  return pimpl->get_date_inperiod_with(d1, d2, property, executor);
 }
 
-Date OrthodoxCalendar::impl::get_date_inperiod_withallof(const Date& d1, const Date& d2,
-      std::span<oxc_const> properties) const
+std::vector<Date> OrthodoxCalendar::get_alldates_with(const Year& year, oxc_const property,
+      const CalendarFormat infmt) const
 {
-  return get_date_inperiod__(d1, d2, properties, &OrthYear::get_date_withallof);
+  return pimpl->get_alldates_with(year, property, infmt);
 }
 
-std::vector<Date> OrthodoxCalendar::impl::get_alldates_withanyof(const Year& year, std::span<oxc_const> properties,
+std::vector<Date> OrthodoxCalendar::get_alldates_with(const int64_t year, oxc_const property,
       const CalendarFormat infmt) const
 {
-  return get_alldates__(year, properties, infmt, &OrthYear::get_alldates_withanyof,
-                                                             &impl::get_alldates_inperiod_withanyof);
+  return pimpl->get_alldates_with(year, property, infmt);
 }
 
-std::vector<Date> OrthodoxCalendar::impl::get_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
-      std::span<oxc_const> properties) const
+std::vector<Date> OrthodoxCalendar::get_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const
 {
-  return get_alldates_inperiod__(d1, d2, properties, &OrthYear::get_alldates_withanyof);
+  return pimpl->get_alldates_inperiod_with(d1, d2, property);
 }
 
-std::string OrthodoxCalendar::impl::get_description_for_date(const Date& d, std::string& datefmt) const
+std::vector<Date> OrthodoxCalendar::get_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property,
+      const Executor& executor) const
 {
-  if(!d) return {};
-  std::string result, buf;
-  auto p = date_properties(d);
-  for(const auto i: p) if(i < 3001) buf += property_title(i) + ' ';
-  if(auto x = std::find(p.begin(), p.end(), oxc::post_petr); x!=p.end())
-        buf += property_title(oxc::post_petr) + ". ";
-  if(auto x = std::find(p.begin(), p.end(), oxc::post_usp); x!=p.end())
-        buf += property_title(oxc::post_usp) + ". ";
-  if(auto x = std::find(p.begin(), p.end(), oxc::post_rojd); x!=p.end())
-        buf += property_title(oxc::post_rojd) + ". ";
-  result = d.format(datefmt) + ' ' + buf;
-  while(!result.empty() && result.front()==' ') result.erase(result.begin());
-  while(!result.empty() && result.back()==' ') result.pop_back();
-  return result;
+  return pimpl->get_alldates_inperiod_with(d1, d2, property, executor);
 }
 
-std::string OrthodoxCalendar::impl::get_description_for_dates(std::span<const Date> days, std::string& datefmt,
-      const std::string& separator) const
+std::vector<CompactDate> OrthodoxCalendar::get_compact_alldates_with(const Year& year, oxc_const property,
+      const CalendarFormat infmt) const
 {
-  std::string res;
-  for(auto it=days.begin(); it!=days.end(); ++it){
-    if(auto s = get_description_for_date(*it, datefmt); !s.empty()){
-      if(it!=days.begin()) res += separator;
-      res += s;
-    }
-  }
-  return res;
+  return pimpl->get_compact_alldates_with(year, property, infmt);
 }
 
-/*----------------------------------------------*/
-/*          class OrthodoxCalendar              */
-/*----------------------------------------------*/
-
-OrthodoxCalendar::OrthodoxCalendar() : pimpl(new OrthodoxCalendar::impl())
+std::vector<CompactDate> OrthodoxCalendar::get_compact_alldates_with(const int64_t year, oxc_const property,
+      const CalendarFormat infmt) const
 {
+  return pimpl->get_compact_alldates_with(year, property, infmt);
 }
 
-OrthodoxCalendar::~OrthodoxCalendar() = default	;
-
-OrthodoxCalendar::OrthodoxCalendar(OrthodoxCalendar&&) noexcept = default;
+std::vector<CompactDate> OrthodoxCalendar::get_compact_alldates_inperiod_with(const Date& d1, const Date& d2,
+      oxc_const property) const
+{
+  return pimpl->get_compact_alldates_inperiod_with(d1, d2, property);
+}
 
-OrthodoxCalendar& OrthodoxCalendar::operator=(OrthodoxCalendar&&) noexcept = default;
+std::vector<CompactDate> OrthodoxCalendar::get_compact_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property,
+      const Executor& executor) const
+{
+  return pimpl->get_compact_alldates_inperiod_with(d1, d2, property, executor);
+}
 
-OrthodoxCalendar::OrthodoxCalendar(const OrthodoxCalendar& other) : pimpl(new OrthodoxCalendar::impl(*other.pimpl))
+Date OrthodoxCalendar::get_date_withanyof(const Year& year, std::span<oxc_const> properties,
+      const CalendarFormat infmt) const
 {
+  return pimpl->get_date_withanyof(year, properties, infmt);
 }
 
-OrthodoxCalendar& OrthodoxCalendar::operator=(const OrthodoxCalendar& other)
+Date OrthodoxCalendar::get_date_withanyof(const int64_t year, std::span<oxc_const> properties,
+      const CalendarFormat infmt) const
 {
-  if(this != &other) pimpl.reset(new OrthodoxCalendar::impl(*other.pimpl));
-  return *this;
+  return pimpl->get_date_withanyof(year, properties, infmt);
 }
 
-bool OrthodoxCalendar::set_winter_indent_weeks_1(const uint8_t w1)
+Date OrthodoxCalendar::get_date_inperiod_withanyof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
 {
-  return pimpl->set_winter_indent_weeks_1(w1);
+  return pimpl->get_date_inperiod_withanyof(d1, d2, properties);
 }
 
-bool OrthodoxCalendar::set_winter_indent_weeks_2(const uint8_t w1, const uint8_t w2)
+Date OrthodoxCalendar::get_date_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+      const Executor& executor) const
 {
-  return pimpl->set_winter_indent_weeks_2(w1, w2);
+  return pimpl->get_date_inperiod_withanyof(d1, d2, properties, executor);
 }
 
-bool OrthodoxCalendar::set_winter_indent_weeks_3(const uint8_t w1, const uint8_t w2, const uint8_t w3)
+Date OrthodoxCalendar::get_date_withallof(const Year& year, std::span<oxc_const> properties,
+      const CalendarFormat infmt) const
 {
-  return pimpl->set_winter_indent_weeks_3(w1, w2, w3);
+  return pimpl->get_date_withallof(year, properties, infmt);
 }
 
-bool OrthodoxCalendar::set_winter_indent_weeks_4(const uint8_t w1, const uint8_t w2, const uint8_t w3, const uint8_t w4)
+Date OrthodoxCalendar::get_date_withallof(const int64_t year, std::span<oxc_const> properties,
+      const CalendarFormat infmt) const
 {
-  return pimpl->set_winter_indent_weeks_4(w1, w2, w3, w4);
+  return pimpl->get_date_withallof(year, properties, infmt);
 }
 
-bool OrthodoxCalendar::set_winter_indent_weeks_5(const uint8_t w1, const uint8_t w2, const uint8_t w3,
-      const uint8_t w4, const uint8_t w5)
+Date OrthodoxCalendar::get_date_inperiod_withallof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
 {
-  return pimpl->set_winter_indent_weeks_5(w1, w2, w3, w4, w5);
+  return pimpl->get_date_inperiod_withallof(d1, d2, properties);
 }
 
-bool OrthodoxCalendar::set_spring_indent_weeks(const uint8_t w1, const uint8_t w2)
+Date OrthodoxCalendar::get_date_inperiod_withallof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+      const Executor& executor) const
 {
-  return pimpl->set_spring_indent_weeks(w1, w2);
+  return pimpl->get_date_inperiod_withallof(d1, d2, properties, executor);
 }
 
-void OrthodoxCalendar::set_spring_indent_apostol(const bool value)
+std::vector<Date> OrthodoxCalendar::get_alldates_withanyof(const Year& year, std::span<oxc_const> properties,
+      const CalendarFormat infmt) const
 {
-  return pimpl->set_spring_indent_apostol(value);
+  return pimpl->get_alldates_withanyof(year, properties, infmt);
 }
 
-std::pair<std::vector<uint8_t>, bool> OrthodoxCalendar::get_options() const
+std::vector<Date> OrthodoxCalendar::get_alldates_withanyof(const int64_t year, std::span<oxc_const> properties,
+      const CalendarFormat infmt) const
 {
-  return pimpl->get_options();
+  return pimpl->get_alldates_withanyof(year, properties, infmt);
 }
 
-std::pair<Month, Day> OrthodoxCalendar::julian_pascha(const Year& year) const
+std::vector<Date> OrthodoxCalendar::get_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
 {
-  return pimpl->julian_pascha(year);
+  return pimpl->get_alldates_inperiod_withanyof(d1, d2, properties);
 }
 
-Date OrthodoxCalendar::pascha(const Year& year, const CalendarFormat infmt) const
+std::vector<Date> OrthodoxCalendar::get_alldates_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+      const Executor& executor) const
 {
-  return pimpl->pascha(year, infmt);
+  return pimpl->get_alldates_inperiod_withanyof(d1, d2, properties, executor);
 }
 
-int8_t OrthodoxCalendar::winter_indent(const Year& year) const
+std::vector<CompactDate> OrthodoxCalendar::get_compact_alldates_withanyof(const Year& year,
+      std::span<oxc_const> properties, const CalendarFormat infmt) const
 {
-  return pimpl->winter_indent(year);
+  return pimpl->get_compact_alldates_withanyof(year, properties, infmt);
 }
 
-int8_t OrthodoxCalendar::spring_indent(const Year& year) const
+std::vector<CompactDate> OrthodoxCalendar::get_compact_alldates_withanyof(const int64_t year, std::span<oxc_const> properties,
+      const CalendarFormat infmt) const
 {
-  return pimpl->spring_indent(year);
+  return pimpl->get_compact_alldates_withanyof(year, properties, infmt);
 }
 
-int8_t OrthodoxCalendar::apostol_post_length(const Year& year) const
+std::vector<CompactDate> OrthodoxCalendar::get_compact_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
 {
-  return pimpl->apostol_post_length(year);
+  return pimpl->get_compact_alldates_inperiod_withanyof(d1, d2, properties);
 }
 
-int8_t OrthodoxCalendar::date_glas(const Year& y, const Month m, const Day d, const CalendarFormat infmt) const
+std::vector<CompactDate> OrthodoxCalendar::get_compact_alldates_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+      const Executor& executor) const
 {
-  return pimpl->date_glas(Date(y, m, d, infmt));
+  return pimpl->get_compact_alldates_inperiod_withanyof(d1, d2, properties, executor);
 }
 
-int8_t OrthodoxCalendar::date_glas(const Date& d) const
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::dates_inperiod_with(const Date& d1, const Date& d2,
+      oxc_const property) const
 {
-  return pimpl->date_glas(d);
+  return pimpl->dates_inperiod_with(d1, d2, property);
 }
 
-int8_t OrthodoxCalendar::date_n50(const Year& y, const Month m, const Day d, const CalendarFormat infmt) const
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::dates_inperiod_withanyof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
 {
-  return pimpl->date_n50(Date(y, m, d, infmt));
+  return pimpl->dates_inperiod_withanyof(d1, d2, properties);
 }
 
-int8_t OrthodoxCalendar::date_n50(const Date& d) const
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::dates_inperiod_withallof(const Date& d1, const Date& d2,
+      std::span<oxc_const> properties) const
 {
-  return pimpl->date_n50(d);
+  return pimpl->dates_inperiod_withallof(d1, d2, properties);
 }
 
-std::vector<uint16_t> OrthodoxCalendar::date_properties(const Year& y, const Month m, const Day d,
+Date OrthodoxCalendar::get_date_where(const Year& year, const DatePredicate& predicate,
       const CalendarFormat infmt) const
 {
-  return pimpl->date_properties(Date(y, m, d, infmt));
+  return pimpl->get_date_where(year, predicate, infmt);
 }
 
-std::vector<uint16_t> OrthodoxCalendar::date_properties(const Date& d) const
+Date OrthodoxCalendar::get_date_where(const int64_t year, const DatePredicate& predicate,
+      const CalendarFormat infmt) const
 {
-  return pimpl->date_properties(d);
+  return pimpl->get_date_where(year, predicate, infmt);
 }
 
-ApEvReads OrthodoxCalendar::date_apostol(const Year& y, const Month m, const Day d, const CalendarFormat infmt) const
+Date OrthodoxCalendar::get_date_inperiod_where(const Date& d1, const Date& d2, const DatePredicate& predicate) const
 {
-  return pimpl->date_apostol(Date(y, m, d, infmt));
+  return pimpl->get_date_inperiod_where(d1, d2, predicate);
 }
 
-ApEvReads OrthodoxCalendar::date_apostol(const Date& d) const
+std::vector<Date> OrthodoxCalendar::get_alldates_where(const Year& year, const DatePredicate& predicate,
+      const CalendarFormat infmt) const
 {
-  return pimpl->date_apostol(d);
+  return pimpl->get_alldates_where(year, predicate, infmt);
 }
 
-ApEvReads OrthodoxCalendar::date_evangelie(const Year& y, const Month m, const Day d, const CalendarFormat infmt) const
+std::vector<Date> OrthodoxCalendar::get_alldates_where(const int64_t year, const DatePredicate& predicate,
+      const CalendarFormat infmt) const
 {
-  return pimpl->date_evangelie(Date(y, m, d, infmt));
+  return pimpl->get_alldates_where(year, predicate, infmt);
 }
 
-ApEvReads OrthodoxCalendar::date_evangelie(const Date& d) const
+std::vector<Date> OrthodoxCalendar::get_alldates_inperiod_where(const Date& d1, const Date& d2,
+      const DatePredicate& predicate) const
 {
-  return pimpl->date_evangelie(d);
+  return pimpl->get_alldates_inperiod_where(d1, d2, predicate);
 }
 
-ApEvReads OrthodoxCalendar::resurrect_evangelie(const Year& y, const Month m, const Day d,
-      const CalendarFormat infmt) const
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::dates_inperiod_where(const Date& d1, const Date& d2,
+      const DatePredicate& predicate) const
 {
-  return pimpl->resurrect_evangelie(Date(y, m, d, infmt));
+  return pimpl->dates_inperiod_where(d1, d2, predicate);
 }
 
-ApEvReads OrthodoxCalendar::resurrect_evangelie(const Date& d) const
+uint64_t OrthodoxCalendar::count_inperiod(const Date& d1, const Date& d2, const DatePredicate& predicate) const
 {
-  return pimpl->resurrect_evangelie(d);
+  return pimpl->count_inperiod(d1, d2, predicate);
 }
 
-bool OrthodoxCalendar::is_date_of(const Year& y, const Month m, const Day d, oxc_const property,
-      const CalendarFormat infmt) const
+bool OrthodoxCalendar::exists_inperiod(const Date& d1, const Date& d2, const DatePredicate& predicate) const
 {
-  return pimpl->is_date_of(Date(y, m, d, infmt), property);
+  return pimpl->exists_inperiod(d1, d2, predicate);
 }
 
-bool OrthodoxCalendar::is_date_of(const Date& d, oxc_const property) const
+OrthodoxCalendar::CompactDatesView OrthodoxCalendar::dates_inperiod_near(const Date& d1, const Date& d2,
+      const DatePredicate& a, const DatePredicate& b, const int min_offset, const int max_offset) const
 {
-  return pimpl->is_date_of(d, property);
+  return pimpl->dates_inperiod_near(d1, d2, a, b, min_offset, max_offset);
 }
 
-Date OrthodoxCalendar::get_date_with(const Year& year, oxc_const property, const CalendarFormat infmt) const
+std::vector<CompactDate> OrthodoxCalendar::get_alldates_inperiod_near(const Date& d1, const Date& d2,
+      const DatePredicate& a, const DatePredicate& b, const int min_offset, const int max_offset) const
 {
-  return pimpl->get_date_with(year, property, infmt);
+  return pimpl->get_alldates_inperiod_near(d1, d2, a, b, min_offset, max_offset);
 }
 
-Date OrthodoxCalendar::get_date_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const
+uint64_t OrthodoxCalendar::count_inperiod_near(const Date& d1, const Date& d2, const DatePredicate& a,
+      const DatePredicate& b, const int min_offset, const int max_offset) const
 {
-  return pimpl->get_date_inperiod_with(d1, d2, property);
+  return pimpl->count_inperiod_near(d1, d2, a, b, min_offset, max_offset);
 }
 
-std::vector<Date> OrthodoxCalendar::get_alldates_with(const Year& year, oxc_const property,
-      const CalendarFormat infmt) const
+Date OrthodoxCalendar::next_date_with(const Date& from, oxc_const property) const
 {
-  return pimpl->get_alldates_with(year, property, infmt);
+  return pimpl->adjacent_date_with(from, property, true);
 }
 
-std::vector<Date> OrthodoxCalendar::get_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const
+Date OrthodoxCalendar::next_date_withanyof(const Date& from, std::span<oxc_const> properties) const
 {
-  return pimpl->get_alldates_inperiod_with(d1, d2, property);
+  return pimpl->adjacent_date_withanyof(from, properties, true);
 }
 
-Date OrthodoxCalendar::get_date_withanyof(const Year& year, std::span<oxc_const> properties,
-      const CalendarFormat infmt) const
+Date OrthodoxCalendar::next_date_withallof(const Date& from, std::span<oxc_const> properties) const
 {
-  return pimpl->get_date_withanyof(year, properties, infmt);
+  return pimpl->adjacent_date_withallof(from, properties, true);
 }
 
-Date OrthodoxCalendar::get_date_inperiod_withanyof(const Date& d1, const Date& d2,
-      std::span<oxc_const> properties) const
+Date OrthodoxCalendar::next_date_where(const Date& from, const DatePredicate& predicate) const
 {
-  return pimpl->get_date_inperiod_withanyof(d1, d2, properties);
+  return pimpl->adjacent_date_where(from, predicate, true);
 }
 
-Date OrthodoxCalendar::get_date_withallof(const Year& year, std::span<oxc_const> properties,
-      const CalendarFormat infmt) const
+Date OrthodoxCalendar::prev_date_with(const Date& from, oxc_const property) const
 {
-  return pimpl->get_date_withallof(year, properties, infmt);
+  return pimpl->adjacent_date_with(from, property, false);
 }
 
-Date OrthodoxCalendar::get_date_inperiod_withallof(const Date& d1, const Date& d2,
-      std::span<oxc_const> properties) const
+Date OrthodoxCalendar::prev_date_withanyof(const Date& from, std::span<oxc_const> properties) const
 {
-  return pimpl->get_date_inperiod_withallof(d1, d2, properties);
+  return pimpl->adjacent_date_withanyof(from, properties, false);
 }
 
-std::vector<Date> OrthodoxCalendar::get_alldates_withanyof(const Year& year, std::span<oxc_const> properties,
-      const CalendarFormat infmt) const
+Date OrthodoxCalendar::prev_date_withallof(const Date& from, std::span<oxc_const> properties) const
 {
-  return pimpl->get_alldates_withanyof(year, properties, infmt);
+  return pimpl->adjacent_date_withallof(from, properties, false);
 }
 
-std::vector<Date> OrthodoxCalendar::get_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
-      std::span<oxc_const> properties) const
+Date OrthodoxCalendar::prev_date_where(const Date& from, const DatePredicate& predicate) const
 {
-  return pimpl->get_alldates_inperiod_withanyof(d1, d2, properties);
+  return pimpl->adjacent_date_where(from, predicate, false);
 }
 
 std::string OrthodoxCalendar::get_description_for_date(const Year& y, const Month m, const Day d,
@@ -4652,6 +7266,12 @@ std::string OrthodoxCalendar::get_description_for_date(const Year& y, const Mont
   return pimpl->get_description_for_date(Date(y, m, d, infmt), datefmt);
 }
 
+std::string OrthodoxCalendar::get_description_for_date(const int64_t y, const Month m, const Day d,
+      const CalendarFormat infmt, std::string datefmt) const
+{
+  return pimpl->get_description_for_date(impl::make_date(y, m, d, infmt), datefmt);
+}
+
 std::string OrthodoxCalendar::get_description_for_date(const Date& d, std::string datefmt) const
 {
   return pimpl->get_description_for_date(d, datefmt);
@@ -4663,4 +7283,10 @@ std::string OrthodoxCalendar::get_description_for_dates(std::span<const Date> da
   return pimpl->get_description_for_dates(days, datefmt, separator);
 }
 
+std::string OrthodoxCalendar::get_description_for_dates(std::span<const CompactDate> days, std::string datefmt,
+      const std::string separator) const
+{
+  return pimpl->get_description_for_dates(days, datefmt, separator);
+}
+
 } //namespace oxc
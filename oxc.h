@@ -27,9 +27,16 @@
 
 #pragma once
 
-#include <cstdint>      // for uint16_t, int8_t, uint8_t
+#include <array>        // for array
+#include <compare>      // for strong_ordering
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint16_t, int8_t, uint8_t, int64_t
+#include <functional>   // for hash
+#include <iterator>     // for input_iterator_tag, default_sentinel_t
+#include <map>          // for map
 #include <memory>       // for allocator, unique_ptr
 #include <optional>     // for optional
+#include <ranges>       // for view_interface
 #include <span>         // for span
 #include <string>       // for string, basic_string
 #include <string_view>  // for string_view, basic_string_view
@@ -65,6 +72,10 @@ constexpr auto MIN_YEAR_VALUE = 2;            ///< допустимый мини
   *  \param [in] fmt выбор типа календаря для вычислений
   */
 bool is_leap_year(const Year& y, const CalendarFormat fmt);
+/**
+  *  Перегруженная версия. Отличается только типом параметров.
+  */
+bool is_leap_year(const int64_t y, const CalendarFormat fmt);
 
 /**
   *  Функция возвращает кол-во дней в месяце
@@ -81,14 +92,79 @@ Day month_length(const Month month, const bool leap);
   */
 std::string property_title(oxc_const property);
 
+class Date;
+
+/**
+ * Компактный класс даты. Хранит только хронологический юлианский номер дня (CJDN) в виде int64_t:
+ * объект тривиально копируемый, занимает 8 байт и подходит для хранения большого кол-ва дат
+ * в массивах и хэш-таблицах. Неявно преобразуется в Date, поэтому может передаваться
+ * везде, где принимается Date. Обратное преобразование явное и бросает исключение std::out_of_range,
+ * если CJDN даты не помещается в int64_t. Пустой объект соответствует пустому Date.
+ */
+class CompactDate {
+  int64_t cjdn_;
+  constexpr explicit CompactDate(int64_t cjdn) noexcept : cjdn_(cjdn) {}
+public:
+  /**
+    *  Создает объект по хронологическому юлианскому номеру дня; бросает исключение если
+    *  номер не соответствует корректной дате (значение -1 создает пустой объект)
+    *
+    *  \param [in] cjdn хронологический юлианский номер дня
+    */
+  static CompactDate from_cjdn(int64_t cjdn);
+  /**
+    *  Конструктор. Создает пустой объект
+    */
+  constexpr CompactDate() noexcept : cjdn_(-1) {}
+  /**
+    *  Конструктор
+    *
+    *  \param [in] y число года
+    *  \param [in] m число месяца
+    *  \param [in] d число дня
+    *  \param [in] fmt тип календаря для вх. даты
+    */
+  CompactDate(const Year& y, const Month m, const Day d, const CalendarFormat fmt=Julian);
+  /**
+   *   Перегруженная версия. Отличается только типом параметров.
+   */
+  CompactDate(const unsigned long long y, const Month m, const Day d, const CalendarFormat fmt=Julian);
+  /**
+    *  Конструктор преобразования из Date
+    */
+  explicit CompactDate(const Date& d);
+  /**
+    *  Возвращает хронологический юлианский номер дня (для пустого объекта -1)
+    */
+  constexpr int64_t cjdn() const noexcept { return cjdn_; }
+  /**
+    *  Возвращает true если объект не содержит корректной даты
+    */
+  constexpr bool empty() const noexcept { return cjdn_ == -1; }
+  /**
+    *  Возвращает true если объект содержит корректную дату
+    */
+  constexpr bool is_valid() const noexcept { return cjdn_ != -1; }
+  constexpr explicit operator bool() const noexcept { return is_valid(); }
+  /**
+    *  Извлекает день недели для даты. 0-вс, 1-пн, 2-вт, 3-ср, 4-чт, 5-пт, 6-сб.
+    */
+  constexpr Weekday weekday() const noexcept { return is_valid() ? static_cast<Weekday>((cjdn_ + 1) % 7) : -1; }
+  constexpr bool operator==(const CompactDate&) const noexcept = default;
+  constexpr std::strong_ordering operator<=>(const CompactDate&) const noexcept = default;
+};
+
 /**
  * Класс даты. Реализует преобразования между 3-мя календарными системами (григорианский, юлианский, ново-юлианский)
  * по методу Dr. Louis Strous'a - https://aa.quae.nl/en/reken/juliaansedag.html
  * Для числа года используется строковое представление. Конструктор принимающий строковое число года,
  * бросает исключение если строку невозможно преобразовать в целое число произвольной величины
  * или если число (во всех календарных форматах) < MIN_YEAR_VALUE.
+ * Константные методы одного объекта можно вызывать одновременно из нескольких потоков.
  */
 class Date {
+  friend class CompactDate;
+  friend class OrthodoxCalendar;
   class impl;
   std::unique_ptr<impl> pimpl;
 public:
@@ -152,6 +228,10 @@ public:
     *  \param [in] fmt тип календаря для вх. даты
     */
   Date(const unsigned long long y, const Month m, const Day d, const CalendarFormat fmt=Julian);
+  /**
+    *  Конструктор преобразования из CompactDate
+    */
+  Date(const CompactDate& d);
   Date(const Date&);
   Date& operator=(const Date&);
   Date(Date&&) noexcept;
@@ -265,12 +345,53 @@ public:
   std::string format(std::string fmt = "%Jd %JM %JY г.") const;
 };
 
+class OrthYear;
+
+/**
+ * Условие отбора дат для методов поиска OrthodoxCalendar с окончанием _where. Строится из элементарных
+ * условий (признак дня, день недели, глас, номер по пятидесятнице) операциями & (и), | (или), ! (не).
+ * Условие компилируется при построении, и для каждого года вычисляется сразу для всех его дней.
+ * Например, воскресные дни великого поста, кроме великих праздников:<br>
+ * `DatePredicate::weekday(0) & DatePredicate::property(oxc::post_vel) & !DatePredicate::property(oxc::vel_prazd)`
+ */
+class DatePredicate {
+  friend class OrthYear;
+  struct plan;
+  std::shared_ptr<const plan> p;
+  explicit DatePredicate(std::shared_ptr<const plan> x) : p(std::move(x)) {}
+public:
+  /**
+   *  Условие: дата имеет признак property
+   *
+   *  \param [in] property любая константа из пространства oxc:: (полный список см. в разделе группы)
+   */
+  static DatePredicate property(oxc_const property);
+  /**
+   *  Условие: дата приходится на день недели w (0-вс, 1-пн, 2-вт, 3-ср, 4-чт, 5-пт, 6-сб)
+   */
+  static DatePredicate weekday(Weekday w);
+  /**
+   *  Условие: глас даты (см. OrthodoxCalendar::date_glas) равен g
+   */
+  static DatePredicate glas(int8_t g);
+  /**
+   *  Условие: номер даты по пятидесятнице (см. OrthodoxCalendar::date_n50) равен n
+   */
+  static DatePredicate n50(int8_t n);
+  friend DatePredicate operator&(const DatePredicate& lhs, const DatePredicate& rhs);
+  friend DatePredicate operator|(const DatePredicate& lhs, const DatePredicate& rhs);
+  friend DatePredicate operator!(const DatePredicate& x);
+};
+
 /**
  * Класс для работы с церковным календарем. Для удобства поиска и календарных вычислений
  * каждая дата может иметь набор свойств (признаков), определенных
  * константами типа oxc_const (полный список см. в разделе группы). Также предусмотрена
  * возможность настроить номера седмиц для расчета отступок / преступок рядовых литургийных
  * чтений (по умолчанию вычисления производится в соответствии с оф. календарем МП РПЦ).
+ * Константные методы одного объекта (в т.ч. с одними и теми же объектами Date в аргументах)
+ * можно вызывать одновременно из нескольких потоков; методы изменения настроек и кэша
+ * (set_*, pin_year, unpin_year) требуют внешней синхронизации с остальными вызовами.
  */
 class OrthodoxCalendar {
   class impl;
@@ -309,6 +430,112 @@ public:
     bool operator==(const ApostolEvangelieReadings&) const = default;
     explicit operator bool() const { return n>0; }
   };
+  /**
+   * список признаков дня фиксированной емкости (результат метода date_property_list). Хранится в самом объекте
+   * без выделения динамической памяти и не зависит от времени жизни календаря.
+   * Признаки упорядочены по возрастанию значений констант.
+   */
+  class PropertyList {
+    friend class OrthodoxCalendar;
+    static constexpr std::size_t CAPACITY = 24;
+    std::array<uint16_t, CAPACITY> items{};
+    std::size_t count{};
+  public:
+    const uint16_t* begin() const { return items.data(); }
+    const uint16_t* end() const { return items.data() + count; }
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    uint16_t operator[](std::size_t i) const { return items[i]; }
+    /**
+     * проверяет наличие признака property в списке
+     */
+    bool contains(uint16_t property) const
+    {
+      for(auto x: *this) if(x == property) return true;
+      return false;
+    }
+    operator std::span<const uint16_t>() const { return {begin(), end()}; }
+  };
+  /**
+   * флаги запрашиваемых полей для пакетного метода dates_info (объединяются операцией |)
+   */
+  enum DatesInfoField : unsigned {
+    info_properties          = 1,  ///< свойства даты (см. date_properties)
+    info_glas                = 2,  ///< глас (см. date_glas)
+    info_n50                 = 4,  ///< номер по пятидесятнице (см. date_n50)
+    info_apostol             = 8,  ///< рядовые чтения Апостола (см. date_apostol)
+    info_evangelie           = 16, ///< рядовые чтения Евангелия (см. date_evangelie)
+    info_resurrect_evangelie = 32, ///< воскресные Евангелия утрени (см. resurrect_evangelie)
+    info_all                 = 63  ///< все поля
+  };
+  /**
+   * результат пакетного метода dates_info: массивы, параллельные входному массиву дат.
+   * Массивы полей, не запрошенных флагами, остаются пустыми.
+   */
+  struct DatesInfo {
+    std::vector<std::vector<uint16_t>> properties;
+    std::vector<int8_t> glas;
+    std::vector<int8_t> n50;
+    std::vector<ApostolEvangelieReadings> apostol;
+    std::vector<ApostolEvangelieReadings> evangelie;
+    std::vector<ApostolEvangelieReadings> resurrect_evangelie;
+  };
+  /**
+   * результат пакетного метода years_info: массивы, параллельные входному массиву годов
+   */
+  struct YearsInfo {
+    std::vector<std::pair<Month, Day>> pascha;
+    std::vector<int8_t> winter_indent;
+    std::vector<int8_t> spring_indent;
+    std::vector<int8_t> apostol_post_length;
+  };
+  /**
+   * ленивая последовательность дат (однопроходный диапазон std::ranges) - результат поиска дат за период.
+   * Даты выдаются по возрастанию; данные каждого года рассчитываются только при переходе к нему,
+   * поэтому прерывание перебора прекращает поиск, а занимаемая память не зависит от длины периода.
+   * Объект календаря, создавший последовательность, должен существовать все время ее использования.
+   */
+  class CompactDatesView : public std::ranges::view_interface<CompactDatesView> {
+    friend class OrthodoxCalendar;
+    struct state;
+    std::shared_ptr<state> st;
+    explicit CompactDatesView(std::shared_ptr<state> s) : st(std::move(s)) {}
+  public:
+    class iterator {
+      friend class CompactDatesView;
+      state* st{};
+      explicit iterator(state* s) : st(s) {}
+    public:
+      using iterator_concept = std::input_iterator_tag;
+      using value_type = CompactDate;
+      using difference_type = std::ptrdiff_t;
+      iterator() = default;
+      const CompactDate& operator*() const;
+      iterator& operator++();
+      void operator++(int) { ++*this; }
+      bool operator==(std::default_sentinel_t) const;
+    };
+    CompactDatesView() = default;
+    /**
+     * начинает перебор. Последовательность однопроходная: повторный вызов продолжает с текущей позиции
+     */
+    iterator begin() const;
+    std::default_sentinel_t end() const { return {}; }
+  };
+  /**
+   * исполнитель для параллельных версий методов поиска за период. Должен вызвать task(i) для всех i
+   * из [0, n) - в любом порядке, в т.ч. одновременно из нескольких потоков, - и вернуть управление
+   * после завершения всех вызовов. Пустой объект означает общий для процесса исполнитель thread_executor().
+   */
+  using Executor = std::function<void(std::size_t n, const std::function<void(std::size_t)>& task)>;
+  /**
+   * Метод возвращает исполнитель, который выполняет задачи в threads потоках (вызывающий поток и threads-1
+   * постоянных потоков, созданных вместе с исполнителем), раздавая их по одной из общей очереди.
+   * При threads=0 используется std::thread::hardware_concurrency(). Копии исполнителя используют одни
+   * и те же потоки и выполняют один вызов за раз: вызов, пришедший во время выполнения другого
+   * (в т.ч. из задачи), выполняется в вызывающем потоке. Потоки завершаются вместе с последней копией.
+   */
+  static Executor thread_executor(unsigned threads=0);
   OrthodoxCalendar();
   OrthodoxCalendar(const OrthodoxCalendar&);
   OrthodoxCalendar& operator=(const OrthodoxCalendar&);
@@ -321,6 +548,10 @@ public:
    *  \param [in] year число года по юлианскому календарю
    */
   std::pair<Month, Day> julian_pascha(const Year& year) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::pair<Month, Day> julian_pascha(const int64_t year) const;
   /**
    *  Метод вычисляет дату православной пасхи; возвращаемый объект может быть пустым если дата
    *  не найдена (эта вероятность появляется из-за особенностей григорианского и новоюлианского календарей, когда
@@ -332,24 +563,107 @@ public:
    *  \param [in] infmt тип календаря для числа года
    */
   Date pascha(const Year& year, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  Date pascha(const int64_t year, const CalendarFormat infmt=Julian) const;
   /**
    *  Метод вычисляет кол-во седмиц зимней отступкu литургийных чтений (значения от -5 до 0)
    *
    *  \param [in] year число года юлианского календаря
    */
   int8_t winter_indent(const Year& year) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  int8_t winter_indent(const int64_t year) const;
   /**
    *  Метод вычисляет кол-во седмиц осенней отступкu \ преступки литургийных чтений (значения от -2 до 3)
    *
    *  \param [in] year число года юлианского календаря
    */
   int8_t spring_indent(const Year& year) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  int8_t spring_indent(const int64_t year) const;
   /**
    *  Метод вычисляет длительность петрова поста в днях (значения от 8 до 42)
    *
    *  \param [in] year число года юлианского календаря
    */
   int8_t apostol_post_length(const Year& year) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  int8_t apostol_post_length(const int64_t year) const;
+  /**
+   *  Пакетная версия методов julian_pascha, winter_indent, spring_indent и apostol_post_length для массива
+   *  юлианских годов. Значения вычисляются арифметически по числу года, без расчета календаря года.
+   *
+   *  \param [in] years массив чисел годов по юлианскому календарю
+   */
+  YearsInfo years_info(std::span<const int64_t> years) const;
+  /**
+   *  Метод возвращает распределение дат православной пасхи за период: дата -> кол-во лет периода с пасхой в эту дату.
+   *  Поскольку дата пасхи по ст. ст. повторяется с периодом пасхалии (532 года), время расчета не зависит от длины
+   *  периода; для outfmt != Julian оно пропорционально числу столетий периода. Для outfmt != Julian даты пасхи
+   *  юлианских годов периода переводятся в календарь outfmt (числа годов в этом случае не должны превышать 10^15).
+   *  Если кол-во лет не помещается в uint64_t, бросается исключение std::overflow_error.
+   *
+   *  \param [in] y1 первый год периода по юлианскому календарю (включительно)
+   *  \param [in] y2 последний год периода по юлианскому календарю (включительно)
+   *  \param [in] outfmt тип календаря для дат пасхи
+   */
+  std::map<std::pair<Month, Day>, uint64_t> pascha_histogram(const Year& y1, const Year& y2,
+        const CalendarFormat outfmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::map<std::pair<Month, Day>, uint64_t> pascha_histogram(const int64_t y1, const int64_t y2,
+        const CalendarFormat outfmt=Julian) const;
+  /**
+   *  Метод возвращает распределение значений зимней отступкu (см. winter_indent) за период юлианских годов
+   *  y1..y2 включительно: значение -> кол-во лет. Время расчета не зависит от длины периода.
+   *  Если кол-во лет не помещается в uint64_t, бросается исключение std::overflow_error.
+   */
+  std::map<int8_t, uint64_t> winter_indent_histogram(const Year& y1, const Year& y2) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::map<int8_t, uint64_t> winter_indent_histogram(const int64_t y1, const int64_t y2) const;
+  /**
+   *  Аналог метода winter_indent_histogram для осенней отступкu \ преступки (см. spring_indent)
+   */
+  std::map<int8_t, uint64_t> spring_indent_histogram(const Year& y1, const Year& y2) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::map<int8_t, uint64_t> spring_indent_histogram(const int64_t y1, const int64_t y2) const;
+  /**
+   *  Аналог метода winter_indent_histogram для длительности петрова поста (см. apostol_post_length)
+   */
+  std::map<int8_t, uint64_t> apostol_post_length_histogram(const Year& y1, const Year& y2) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::map<int8_t, uint64_t> apostol_post_length_histogram(const int64_t y1, const int64_t y2) const;
+  /**
+   *  Метод возвращает распределение дней недели (воскресенье=0) непереходящего праздника за период юлианских
+   *  годов y1..y2 включительно: день недели -> кол-во лет. Время расчета не зависит от длины периода.
+   *  Если кол-во лет не помещается в uint64_t, бросается исключение std::overflow_error.
+   *  Если property не является признаком непереходящего праздника (от oxc::m1d1 до oxc::m12d31),
+   *  бросается исключение std::runtime_error.
+   *
+   *  \param [in] y1 первый год периода по юлианскому календарю (включительно)
+   *  \param [in] y2 последний год периода по юлианскому календарю (включительно)
+   *  \param [in] property признак непереходящего праздника
+   */
+  std::map<Weekday, uint64_t> weekday_histogram(const Year& y1, const Year& y2, oxc_const property) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::map<Weekday, uint64_t> weekday_histogram(const int64_t y1, const int64_t y2, oxc_const property) const;
   /**
    *  Метод вычисляет глас для указанной даты (значения от 1 до 8. для периода от
    *  суб.лазаревой до недели всех святых: значение < 1)
@@ -360,6 +674,10 @@ public:
    *  \param [in] infmt тип календаря для даты
    */
   int8_t date_glas(const Year& y, const Month m, const Day d, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  int8_t date_glas(const int64_t y, const Month m, const Day d, const CalendarFormat infmt=Julian) const;
   /**
    *  Перегруженная версия. Отличается только типом параметров.
    */
@@ -375,6 +693,10 @@ public:
    *    для периода от начала вел.поста до тр.род.субботы = -1
    */
   int8_t date_n50(const Year& y, const Month m, const Day d, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  int8_t date_n50(const int64_t y, const Month m, const Day d, const CalendarFormat infmt=Julian) const;
   /**
    *  Перегруженная версия. Отличается только типом параметров.
    */
@@ -393,7 +715,30 @@ public:
   /**
    *  Перегруженная версия. Отличается только типом параметров.
    */
+  std::vector<uint16_t> date_properties(const int64_t y, const Month m, const Day d,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
   std::vector<uint16_t> date_properties(const Date& d) const;
+  /**
+   *  Аналог метода date_properties, не выделяющий динамическую память: признаки даты
+   *  возвращаются в списке фиксированной емкости
+   *
+   *  \param [in] y число года
+   *  \param [in] m число месяца
+   *  \param [in] d число дня
+   *  \param [in] infmt тип календаря для даты
+   */
+  PropertyList date_property_list(const Year& y, const Month m, const Day d, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  PropertyList date_property_list(const int64_t y, const Month m, const Day d, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  PropertyList date_property_list(const Date& d) const;
   /**
    *  Метод вычисляет рядовые литургийные чтения Апостола указанной даты. Праздники не учитываются.
    *  Возвращаемое значение может быть пустым
@@ -408,6 +753,11 @@ public:
   /**
    *  Перегруженная версия. Отличается только типом параметров.
    */
+  ApostolEvangelieReadings date_apostol(const int64_t y, const Month m, const Day d,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
   ApostolEvangelieReadings date_apostol(const Date& d) const;
   /**
    *  Метод вычисляет рядовые литургийные чтения Евангелия указанной даты. Праздники не учитываются.
@@ -423,6 +773,11 @@ public:
   /**
    *  Перегруженная версия. Отличается только типом параметров.
    */
+  ApostolEvangelieReadings date_evangelie(const int64_t y, const Month m, const Day d,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
   ApostolEvangelieReadings date_evangelie(const Date& d) const;
   /**
    *  Метод вычисляет воскресные Евангелия утрени для указанной даты. Возвращаемое значение может быть пустым
@@ -437,7 +792,26 @@ public:
   /**
    *  Перегруженная версия. Отличается только типом параметров.
    */
+  ApostolEvangelieReadings resurrect_evangelie(const int64_t y, const Month m, const Day d,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
   ApostolEvangelieReadings resurrect_evangelie(const Date& d) const;
+  /**
+   *  Пакетная версия методов date_properties, date_glas, date_n50, date_apostol, date_evangelie и
+   *  resurrect_evangelie. Даты группируются по году пасхального цикла, поэтому данные каждого года
+   *  запрашиваются один раз на группу; порядок дат во входном массиве не важен.
+   *  Бросает исключение, если массив содержит пустую дату.
+   *
+   *  \param [in] dates массив дат
+   *  \param [in] fields запрашиваемые поля (флаги DatesInfoField)
+   */
+  DatesInfo dates_info(std::span<const CompactDate> dates, unsigned fields=info_all) const;
+  /**
+   *  Параллельная версия: группы дат распределяются между задачами исполнителя executor.
+   */
+  DatesInfo dates_info(std::span<const CompactDate> dates, unsigned fields, const Executor& executor) const;
   /**
    *  Метод проверяет соответствует ли указанная дата признаку property
    *
@@ -452,6 +826,11 @@ public:
   /**
    *  Перегруженная версия. Отличается только типом параметров.
    */
+  bool is_date_of(const int64_t y, const Month m, const Day d, oxc_const property,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
   bool is_date_of(const Date& d, oxc_const property) const;
   /**
    *  Метод возвращает первую найденную дату в указанном году, соответствующую параметру property
@@ -461,6 +840,10 @@ public:
    *  \param [in] infmt тип календаря для числа года
    */
   Date get_date_with(const Year& year, oxc_const property, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  Date get_date_with(const int64_t year, oxc_const property, const CalendarFormat infmt=Julian) const;
   /**
    *  Метод возвращает первую найденную дату за указанный период, соответствующую параметру property
    *
@@ -469,6 +852,11 @@ public:
    *  \param [in] property любая константа из пространства oxc:: (полный список см. в разделе группы)
    */
   Date get_date_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const;
+  /**
+   *  Параллельная версия: годы периода распределяются между задачами исполнителя executor;
+   *  после нахождения даты задачи для более поздних лет пропускаются.
+   */
+  Date get_date_inperiod_with(const Date& d1, const Date& d2, oxc_const property, const Executor& executor) const;
   /**
    *  Метод возвращает все даты в указанном году, соответствующие параметру property; или пустой вектор
    *       если ни одна дата не найдена
@@ -478,6 +866,10 @@ public:
    *  \param [in] infmt тип календаря для числа года
    */
   std::vector<Date> get_alldates_with(const Year& year, oxc_const property, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::vector<Date> get_alldates_with(const int64_t year, oxc_const property, const CalendarFormat infmt=Julian) const;
   /**
    *  Метод возвращает все даты за указанный период, соответствующие параметру property; или пустой вектор
    *       если ни одна дата не найдена
@@ -487,6 +879,41 @@ public:
    *  \param [in] property любая константа из пространства oxc:: (полный список см. в разделе группы)
    */
   std::vector<Date> get_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const;
+  /**
+   *  Параллельная версия: годы периода распределяются между задачами исполнителя executor,
+   *  результаты объединяются в порядке возрастания дат.
+   */
+  std::vector<Date> get_alldates_inperiod_with(const Date& d1, const Date& d2, oxc_const property,
+        const Executor& executor) const;
+  /**
+   *  Метод аналогичен get_alldates_with, но возвращает массив компактных дат
+   *
+   *  \param [in] year число года
+   *  \param [in] property любая константа из пространства oxc:: (полный список см. в разделе группы)
+   *  \param [in] infmt тип календаря для числа года
+   */
+  std::vector<CompactDate> get_compact_alldates_with(const Year& year, oxc_const property,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::vector<CompactDate> get_compact_alldates_with(const int64_t year, oxc_const property,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Метод аналогичен get_alldates_inperiod_with, но возвращает массив компактных дат
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] property любая константа из пространства oxc:: (полный список см. в разделе группы)
+   */
+  std::vector<CompactDate> get_compact_alldates_inperiod_with(const Date& d1, const Date& d2,
+        oxc_const property) const;
+  /**
+   *  Параллельная версия: годы периода распределяются между задачами исполнителя executor,
+   *  результаты объединяются в порядке возрастания дат.
+   */
+  std::vector<CompactDate> get_compact_alldates_inperiod_with(const Date& d1, const Date& d2,
+        oxc_const property, const Executor& executor) const;
   /**
    *  Метод возвращает первую найденную дату в указанном году, соответствующую любому из элементов второго параметра
    *
@@ -495,6 +922,10 @@ public:
    *  \param [in] infmt тип календаря для числа года
    */
   Date get_date_withanyof(const Year& year, std::span<oxc_const> properties, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  Date get_date_withanyof(const int64_t year, std::span<oxc_const> properties, const CalendarFormat infmt=Julian) const;
   /**
    *  Метод возвращает первую найденную дату за указанный период, соответствующую
    *  любому из элементов параметра properties
@@ -504,6 +935,12 @@ public:
    *  \param [in] properties массив констант из пространства oxc:: (полный список см. в разделе группы)
    */
   Date get_date_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties) const;
+  /**
+   *  Параллельная версия: годы периода распределяются между задачами исполнителя executor;
+   *  после нахождения даты задачи для более поздних лет пропускаются.
+   */
+  Date get_date_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+        const Executor& executor) const;
   /**
    *  Метод возвращает первую найденную дату в указанном году, соответствующую всем элементам параметра properties
    *
@@ -512,6 +949,10 @@ public:
    *  \param [in] infmt тип календаря для числа года
    */
   Date get_date_withallof(const Year& year, std::span<oxc_const> properties, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  Date get_date_withallof(const int64_t year, std::span<oxc_const> properties, const CalendarFormat infmt=Julian) const;
   /**
    *  Метод возвращает первую найденную дату за указанный период, соответствующую всем элементам параметра properties
    *
@@ -520,6 +961,12 @@ public:
    *  \param [in] properties массив констант из пространства oxc:: (полный список см. в разделе группы)
    */
   Date get_date_inperiod_withallof(const Date& d1, const Date& d2, std::span<oxc_const> properties) const;
+  /**
+   *  Параллельная версия: годы периода распределяются между задачами исполнителя executor;
+   *  после нахождения даты задачи для более поздних лет пропускаются.
+   */
+  Date get_date_inperiod_withallof(const Date& d1, const Date& d2, std::span<oxc_const> properties,
+        const Executor& executor) const;
   /**
    *  Метод возвращает все даты в указанном году, соответствующие любому из элементов параметра properties
    *
@@ -529,6 +976,11 @@ public:
    */
   std::vector<Date> get_alldates_withanyof(const Year& year, std::span<oxc_const> properties,
         const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::vector<Date> get_alldates_withanyof(const int64_t year, std::span<oxc_const> properties,
+        const CalendarFormat infmt=Julian) const;
   /**
    *  Метод возвращает все даты за указанный период, соответствующие любому из элементов параметра properties
    *
@@ -538,6 +990,206 @@ public:
    */
   std::vector<Date> get_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
         std::span<oxc_const> properties) const;
+  /**
+   *  Параллельная версия: годы периода распределяются между задачами исполнителя executor,
+   *  результаты объединяются в порядке возрастания дат.
+   */
+  std::vector<Date> get_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
+        std::span<oxc_const> properties, const Executor& executor) const;
+  /**
+   *  Метод аналогичен get_alldates_withanyof, но возвращает массив компактных дат
+   *
+   *  \param [in] year число года
+   *  \param [in] properties массив констант из пространства oxc:: (полный список см. в разделе группы)
+   *  \param [in] infmt тип календаря для числа года
+   */
+  std::vector<CompactDate> get_compact_alldates_withanyof(const Year& year, std::span<oxc_const> properties,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::vector<CompactDate> get_compact_alldates_withanyof(const int64_t year, std::span<oxc_const> properties,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Метод аналогичен get_alldates_inperiod_withanyof, но возвращает массив компактных дат
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] properties массив констант из пространства oxc:: (полный список см. в разделе группы)
+   */
+  std::vector<CompactDate> get_compact_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
+        std::span<oxc_const> properties) const;
+  /**
+   *  Параллельная версия: годы периода распределяются между задачами исполнителя executor,
+   *  результаты объединяются в порядке возрастания дат.
+   */
+  std::vector<CompactDate> get_compact_alldates_inperiod_withanyof(const Date& d1, const Date& d2,
+        std::span<oxc_const> properties, const Executor& executor) const;
+  /**
+   *  Метод возвращает ленивую последовательность всех дат за указанный период, соответствующих параметру property.
+   *  Границы периода должны быть представимы в виде CompactDate (иначе бросается исключение std::out_of_range)
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] property константа из пространства oxc:: (полный список см. в разделе группы)
+   */
+  CompactDatesView dates_inperiod_with(const Date& d1, const Date& d2, oxc_const property) const;
+  /**
+   *  Метод аналогичен dates_inperiod_with, но выдает даты, соответствующие любому из элементов параметра properties.
+   *  В отличие от get_alldates_inperiod_withanyof, последовательность упорядочена по возрастанию без повторов:
+   *  дата выдается один раз, даже если ей соответствуют несколько (в т.ч. повторяющихся) элементов properties.
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] properties массив констант из пространства oxc:: (полный список см. в разделе группы)
+   */
+  CompactDatesView dates_inperiod_withanyof(const Date& d1, const Date& d2, std::span<oxc_const> properties) const;
+  /**
+   *  Метод аналогичен dates_inperiod_with, но выдает даты, соответствующие всем элементам параметра properties
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] properties массив констант из пространства oxc:: (полный список см. в разделе группы)
+   */
+  CompactDatesView dates_inperiod_withallof(const Date& d1, const Date& d2, std::span<oxc_const> properties) const;
+  /**
+   *  Метод возвращает первую дату в указанном году, удовлетворяющую условию predicate
+   *
+   *  \param [in] year число года
+   *  \param [in] predicate условие отбора дат
+   *  \param [in] infmt тип календаря для числа года
+   */
+  Date get_date_where(const Year& year, const DatePredicate& predicate, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  Date get_date_where(const int64_t year, const DatePredicate& predicate, const CalendarFormat infmt=Julian) const;
+  /**
+   *  Метод возвращает первую дату за указанный период, удовлетворяющую условию predicate
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] predicate условие отбора дат
+   */
+  Date get_date_inperiod_where(const Date& d1, const Date& d2, const DatePredicate& predicate) const;
+  /**
+   *  Метод возвращает все даты в указанном году, удовлетворяющие условию predicate
+   *
+   *  \param [in] year число года
+   *  \param [in] predicate условие отбора дат
+   *  \param [in] infmt тип календаря для числа года
+   */
+  std::vector<Date> get_alldates_where(const Year& year, const DatePredicate& predicate,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::vector<Date> get_alldates_where(const int64_t year, const DatePredicate& predicate,
+        const CalendarFormat infmt=Julian) const;
+  /**
+   *  Метод возвращает все даты за указанный период, удовлетворяющие условию predicate
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] predicate условие отбора дат
+   */
+  std::vector<Date> get_alldates_inperiod_where(const Date& d1, const Date& d2, const DatePredicate& predicate) const;
+  /**
+   *  Метод аналогичен dates_inperiod_with, но выдает даты, удовлетворяющие условию predicate
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] predicate условие отбора дат
+   */
+  CompactDatesView dates_inperiod_where(const Date& d1, const Date& d2, const DatePredicate& predicate) const;
+  /**
+   *  Метод возвращает количество дат за указанный период, удовлетворяющих условию predicate.
+   *  Объекты дат при этом не создаются. Если количество не помещается в uint64_t,
+   *  бросается исключение std::overflow_error.
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] predicate условие отбора дат
+   */
+  uint64_t count_inperiod(const Date& d1, const Date& d2, const DatePredicate& predicate) const;
+  /**
+   *  Метод возвращает true, если за указанный период есть хотя бы одна дата, удовлетворяющая условию predicate.
+   *  Объекты дат при этом не создаются.
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] predicate условие отбора дат
+   */
+  bool exists_inperiod(const Date& d1, const Date& d2, const DatePredicate& predicate) const;
+  /**
+   *  Метод возвращает ленивую последовательность дат за указанный период, удовлетворяющих условию a,
+   *  для которых найдется дата, удовлетворяющая условию b, со смещением (в днях) от min_offset до max_offset
+   *  включительно. Например: [0, 0] - в тот же день; [-k, k] - не далее k дней; [1, k] - дата a раньше даты b.
+   *  Окно смещений может выходить за пределы года и периода.
+   *
+   *  \param [in] d1 верхняя граница периода времени для поиска (включительно)
+   *  \param [in] d2 нижняя граница периода времени для поиска (включительно)
+   *  \param [in] a условие отбора дат
+   *  \param [in] b условие для парной даты
+   *  \param [in] min_offset наименьшее смещение парной даты относительно даты a (не меньше -366)
+   *  \param [in] max_offset наибольшее смещение парной даты относительно даты a (не больше 366)
+   */
+  CompactDatesView dates_inperiod_near(const Date& d1, const Date& d2, const DatePredicate& a,
+        const DatePredicate& b, const int min_offset, const int max_offset) const;
+  /**
+   *  Аналог метода dates_inperiod_near, возвращающий массив дат
+   */
+  std::vector<CompactDate> get_alldates_inperiod_near(const Date& d1, const Date& d2, const DatePredicate& a,
+        const DatePredicate& b, const int min_offset, const int max_offset) const;
+  /**
+   *  Аналог метода dates_inperiod_near, возвращающий количество дат. Объекты дат при этом не создаются,
+   *  а время расчета не зависит от длины периода. Если количество не помещается в uint64_t,
+   *  бросается исключение std::overflow_error.
+   */
+  uint64_t count_inperiod_near(const Date& d1, const Date& d2, const DatePredicate& a,
+        const DatePredicate& b, const int min_offset, const int max_offset) const;
+  /**
+   *  Метод возвращает следующую за from дату, соответствующую признаку property (дата from не включается).
+   *  Поиск ведется по годам вперед от года from; поскольку набор дней с признаками повторяется
+   *  с периодом пасхалии (532 года), при отсутствии даты в течение этого периода возвращается пустой объект.
+   *
+   *  \param [in] from дата, от которой ведется поиск
+   *  \param [in] property признак дня
+   */
+  Date next_date_with(const Date& from, oxc_const property) const;
+  /**
+   *  Аналог метода next_date_with: дата должна соответствовать любому из элементов параметра properties
+   */
+  Date next_date_withanyof(const Date& from, std::span<oxc_const> properties) const;
+  /**
+   *  Аналог метода next_date_with: дата должна соответствовать всем элементам параметра properties
+   */
+  Date next_date_withallof(const Date& from, std::span<oxc_const> properties) const;
+  /**
+   *  Аналог метода next_date_with: дата должна удовлетворять условию predicate
+   */
+  Date next_date_where(const Date& from, const DatePredicate& predicate) const;
+  /**
+   *  Метод возвращает предыдущую за from дату, соответствующую признаку property (дата from не включается).
+   *  Поиск ведется по годам назад от года from; поскольку набор дней с признаками повторяется
+   *  с периодом пасхалии (532 года), при отсутствии даты в течение этого периода возвращается пустой объект.
+   *
+   *  \param [in] from дата, от которой ведется поиск
+   *  \param [in] property признак дня
+   */
+  Date prev_date_with(const Date& from, oxc_const property) const;
+  /**
+   *  Аналог метода prev_date_with: дата должна соответствовать любому из элементов параметра properties
+   */
+  Date prev_date_withanyof(const Date& from, std::span<oxc_const> properties) const;
+  /**
+   *  Аналог метода prev_date_with: дата должна соответствовать всем элементам параметра properties
+   */
+  Date prev_date_withallof(const Date& from, std::span<oxc_const> properties) const;
+  /**
+   *  Аналог метода prev_date_with: дата должна удовлетворять условию predicate
+   */
+  Date prev_date_where(const Date& from, const DatePredicate& predicate) const;
   /**
    *  Метод возвращает текстовое описание даты.
    *
@@ -552,6 +1204,11 @@ public:
   /**
    *  Перегруженная версия. Отличается только типом параметров.
    */
+  std::string get_description_for_date(const int64_t y, const Month m, const Day d,
+        const CalendarFormat infmt=Julian, std::string datefmt = "%Jd %JM %JY г.") const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
   std::string get_description_for_date(const Date& d, std::string datefmt = "%Jd %JM %JY г.") const;
   /**
    *  Метод возвращает текстовое описание нескольких дат.
@@ -562,6 +1219,11 @@ public:
    */
   std::string get_description_for_dates(std::span<const Date> days, std::string datefmt = "%Jd %JM %JY г.",
         const std::string separator="\n") const;
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  std::string get_description_for_dates(std::span<const CompactDate> days, std::string datefmt = "%Jd %JM %JY г.",
+        const std::string separator="\n") const;
   /**
    *  Метод для установки номера добавочной седмицы зимней отступкu литургийных чтений, при отступке в 1 седмиц.
    *
@@ -632,6 +1294,54 @@ public:
    *  Возвращаемый bool это флаг определяющий учитывать ли апостол, при вычислении осенней отступкu литургийных чтений.
    */
   std::pair<std::vector<uint8_t>, bool> get_options() const;
+  /**
+   *  Метод устанавливает лимит памяти (в байтах) для кэша рассчитанных годов. При превышении лимита
+   *  из кэша удаляются годы, к которым дольше всего не было обращений (кроме закрепленных методом pin_year).
+   *  По умолчанию лимит равен 64 Мб.
+   */
+  void set_cache_limit(const std::size_t bytes);
+  /**
+   *  Метод возвращает текущий лимит памяти (в байтах) для кэша рассчитанных годов.
+   */
+  std::size_t cache_limit() const;
+  /**
+   *  Метод возвращает оценку памяти (в байтах), занимаемой кэшем рассчитанных годов.
+   */
+  std::size_t cache_memory_usage() const;
+  /**
+   *  Метод переключает объект на общий для всего процесса кэш рассчитанных годов (value=true)
+   *  или на собственный кэш объекта (value=false). Содержимое прежнего кэша объектом больше не используется.
+   *  Общий кэш разделяется всеми объектами, которые его используют, в т.ч. с разными настройками отступок;
+   *  копирование такого объекта не копирует кэш. Лимит памяти и закрепленные годы (см. set_cache_limit,
+   *  pin_year) у общего кэша также общие. По умолчанию используется собственный кэш.
+   */
+  void set_shared_cache(const bool value=true);
+  /**
+   *  Метод возвращает true, если объект использует общий для всего процесса кэш рассчитанных годов.
+   */
+  bool shared_cache() const;
+  /**
+   *  Метод закрепляет год в кэше: рассчитанные данные этого года не удаляются при превышении лимита памяти.
+   *  Так как данные года повторяются с периодом 532 года, закрепление действует на все годы,
+   *  отличающиеся от year на число, кратное 532.
+   *
+   *  \param [in] year число года по юлианскому календарю
+   */
+  void pin_year(const Year& year);
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  void pin_year(const int64_t year);
+  /**
+   *  Метод отменяет закрепление года в кэше, установленное методом pin_year.
+   *
+   *  \param [in] year число года по юлианскому календарю
+   */
+  void unpin_year(const Year& year);
+  /**
+   *  Перегруженная версия. Отличается только типом параметров.
+   */
+  void unpin_year(const int64_t year);
 };
 
 /**
@@ -1002,3 +1712,8 @@ oxc_const sobor_german            = 6047;///< Собор святых, в зем
 /** @} */
 
 }// namespace oxc
+
+template<>
+struct std::hash<oxc::CompactDate> {
+  std::size_t operator()(const oxc::CompactDate& d) const noexcept { return std::hash<int64_t>{}(d.cjdn()); }
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdlib>
+#include <iostream>
+
+//проверка условия теста: при невыполнении печатает место и выражение, тест завершается с ошибкой
+inline int check_failures = 0;
+
+#define CHECK(expr) \
+  do { \
+    if(!(expr)) { \
+      ++check_failures; \
+      std::cerr << __FILE__ << ':' << __LINE__ << ": CHECK(" #expr ") failed\n"; \
+    } \
+  } while(0)
+
+inline int check_result()
+{
+  if(check_failures) std::cerr << check_failures << " check(s) failed\n";
+  return check_failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+//одновременные константные запросы к общим объектам OrthodoxCalendar и Date из нескольких потоков.
+//результаты сравниваются с последовательным расчетом на отдельном объекте календаря;
+//для проверки гонок данных тест следует собрать с -fsanitize=thread
+#include "oxc.h"
+#include "check.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace oxc;
+
+namespace {
+
+//сводка результатов запросов в виде строки - для сравнения между потоками
+std::string digest(const OrthodoxCalendar& c, const std::vector<Date>& dates)
+{
+  std::string r;
+  for(const Date& d: dates) {
+    for(auto fmt: {Julian, Grigorian, Milankovic}) {
+      const auto [y, m, dd] = d.ymd(fmt);
+      r += y + '.' + std::to_string(m) + '.' + std::to_string(dd) + ' ' + d.year(fmt) + ' ';
+    }
+    r += d.format("%Jd %JM %JY %Gd.%Gm.%GY %Md.%Mm.%MY %wd") + ' ';
+    r += std::to_string(c.date_glas(d)) + ' ' + std::to_string(c.date_n50(d)) + ' ';
+    r += std::to_string(c.date_apostol(d).zach()) + ' ' + std::to_string(c.date_evangelie(d).zach()) + ' ';
+    for(auto p: c.date_properties(d)) r += std::to_string(p) + ',';
+    r += c.is_date_of(d, pasha) ? "P;" : ";";
+  }
+  const Date& a = dates.front();
+  const Date& b = dates[1];
+  r += c.get_date_inperiod_with(a, b, m1d6).format() + ';';
+  for(const Date& d: c.get_alldates_inperiod_with(a, b, pasha)) r += d.format() + ',';
+  r += std::to_string(c.count_inperiod(a, b, DatePredicate::weekday(0) & DatePredicate::property(dvana10_nep_prazd)));
+  r += ';' + std::to_string(c.get_compact_alldates_inperiod_with(a, b, sub_peredbogoyav).size());
+  for(const CompactDate& x: c.dates_inperiod_with(a, b, m12d25)) r += std::to_string(x.cjdn()) + ',';
+  r += c.next_date_with(a, pasha).format() + c.prev_date_with(b, pasha).format() + ';';
+  const auto info = c.dates_info(c.get_compact_alldates_inperiod_with(a, b, vel_post_d1n1));
+  for(auto g: info.glas) r += std::to_string(g) + ',';
+  return r;
+}
+
+}
+
+int main()
+{
+  //общие объекты дат; часть создана в юлианском, часть в григорианском формате и по большому номеру года.
+  //эталон считается по отдельным копиям, чтобы потоки первыми обращались к общим объектам
+  const auto make_dates = [] {
+    return std::vector<Date>{
+      Date(1990, 3, 1), Date(2012, 2, 28, Grigorian), Date(2000, 12, 31), Date(2024, 1, 7, Grigorian),
+      Date("123456789012345678901", 4, 15), Date(1000000000000000ULL, 1, 1, Milankovic),
+      Date(CompactDate(Date(2024, 1, 7)))
+    };
+  };
+  OrthodoxCalendar ref;
+  const std::string expected = digest(ref, make_dates());
+  const std::vector<Date> dates = make_dates();
+
+  OrthodoxCalendar c;
+  //малый лимит кэша заставляет потоки одновременно добавлять и вытеснять годы
+  c.set_cache_limit(16 * 1024);
+  const unsigned threads = 8;
+  std::atomic<unsigned> mismatches{0};
+  std::vector<std::thread> pool;
+  for(unsigned t = 0; t < threads; ++t) {
+    pool.emplace_back([&] {
+      for(int i = 0; i < 2; ++i) {
+        if(digest(c, dates) != expected) ++mismatches;
+      }
+    });
+  }
+  for(auto& th: pool) th.join();
+  CHECK(mismatches == 0);
+  return check_result();
+}
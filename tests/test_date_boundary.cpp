@@ -0,0 +1,95 @@
+//переход даты между представлениями int64_t и big_int:
+//год MAX_FAST_YEAR (1e15) и хронологический юлианский номер дня MAX_FAST_CJDN (4e17)
+#include "oxc.h"
+#include "check.h"
+#include <array>
+#include <string>
+
+using namespace oxc;
+
+namespace {
+
+constexpr int64_t MAX_FAST_YEAR = 1'000'000'000'000'000;
+constexpr int64_t MAX_FAST_CJDN = 400'000'000'000'000'000;
+constexpr std::array formats = {Julian, Grigorian, Milankovic};
+
+int64_t fdiv(int64_t a, int64_t b) { return (a - (a < 0 ? b - 1 : 0)) / b; }
+
+//cjdn юлианской даты, независимый расчет в int64_t
+int64_t julian_cjdn(int64_t y, int m, int d)
+{
+  const int64_t c0 = fdiv(m - 3, 12);
+  return fdiv(1461 * (y + c0), 4) + fdiv(153 * m - 1836 * c0 - 457, 5) + d + 1721117;
+}
+
+//дата совпадает с датой, построенной по ее разложению в любом календаре
+void check_roundtrip(const Date& x)
+{
+  for(auto fmt: formats) {
+    const auto [y, m, d] = x.ymd(fmt);
+    CHECK(Date(y, m, d, fmt) == x);
+    CHECK(x.year(fmt) == y && x.month(fmt) == m && x.day(fmt) == d);
+  }
+}
+
+void check_year_boundary()
+{
+  for(int64_t y: {MAX_FAST_YEAR - 1, MAX_FAST_YEAR, MAX_FAST_YEAR + 1}) {
+    const auto ys = std::to_string(y);
+    for(auto fmt: formats) {
+      const Date a(static_cast<unsigned long long>(y), 3, 1, fmt);
+      const Date b(ys, 3, 1, fmt);
+      CHECK(a == b);
+      CHECK(a.year(fmt) == ys && a.month(fmt) == 3 && a.day(fmt) == 1);
+      check_roundtrip(a);
+    }
+    for(int m: {1, 2, 3, 12}) {
+      const Date x(static_cast<unsigned long long>(y), m, 28);
+      CHECK(CompactDate(x).cjdn() == julian_cjdn(y, m, 28));
+    }
+  }
+  const Date last(static_cast<unsigned long long>(MAX_FAST_YEAR), 12, 31);
+  const Date first(std::to_string(MAX_FAST_YEAR + 1), 1, 1);
+  CHECK(last < first && last <= first && first > last && first >= last && last != first);
+  CHECK(last.inc_by_days() == first);
+  CHECK(first.dec_by_days() == last);
+  CHECK(last.inc_by_days(365) == Date(static_cast<unsigned long long>(MAX_FAST_YEAR + 1), 12, 31));
+  CHECK(first.dec_by_days(366) == Date(static_cast<unsigned long long>(MAX_FAST_YEAR), 1, 1));
+}
+
+void check_cjdn_boundary()
+{
+  for(int64_t c: {MAX_FAST_CJDN - 1, MAX_FAST_CJDN, MAX_FAST_CJDN + 1, MAX_FAST_CJDN + 2}) {
+    const Date x(CompactDate::from_cjdn(c));
+    const auto [y, m, d] = x.ymd();
+    CHECK(julian_cjdn(std::stoll(y), m, d) == c);
+    CHECK(Date(std::stoull(y), m, d) == x);
+    CHECK(CompactDate(x).cjdn() == c);
+    CHECK(x.weekday() == (c + 1) % 7);
+    check_roundtrip(x);
+  }
+  const Date lo(CompactDate::from_cjdn(MAX_FAST_CJDN));
+  const Date hi(CompactDate::from_cjdn(MAX_FAST_CJDN + 1));
+  CHECK(lo < hi && lo <= hi && hi > lo && hi >= lo && lo != hi);
+  CHECK(!(hi < lo) && !(lo == hi));
+  CHECK(lo.inc_by_days() == hi);
+  CHECK(hi.dec_by_days() == lo);
+  const Date a(CompactDate::from_cjdn(MAX_FAST_CJDN - 5));
+  const Date b(CompactDate::from_cjdn(MAX_FAST_CJDN + 5));
+  CHECK(a.inc_by_days(10) == b);
+  CHECK(b.dec_by_days(10) == a);
+  CHECK(a.inc_by_days(10).dec_by_days(10) == a);
+  //дата за границей, заданная годом, совпадает с полученной арифметикой
+  const auto [y, m, d] = b.ymd(Grigorian);
+  CHECK(Date(y, m, d, Grigorian) == b);
+  CHECK(Date(y, m, d, Grigorian) > a);
+}
+
+}
+
+int main()
+{
+  check_year_boundary();
+  check_cjdn_boundary();
+  return check_result();
+}
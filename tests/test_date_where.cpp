@@ -0,0 +1,59 @@
+//поиск первой даты по условию (get_date_where, get_date_inperiod_where) для периодов и гражданских годов,
+//не совпадающих с юлианскими годами, в сравнении с поиском всех дат и подсчетом
+#include "oxc.h"
+#include "check.h"
+#include <vector>
+
+using namespace oxc;
+
+namespace {
+
+void check_period(const OrthodoxCalendar& c, const Date& d1, const Date& d2, const DatePredicate& p)
+{
+  const auto all = c.get_alldates_inperiod_where(d1, d2, p);
+  CHECK(all.size() == c.count_inperiod(d1, d2, p));
+  const Date first = c.get_date_inperiod_where(d1, d2, p);
+  CHECK(all.empty() ? first.empty() : first == all.front());
+  CHECK(c.exists_inperiod(d1, d2, p) == !all.empty());
+}
+
+void check_year(const OrthodoxCalendar& c, const int64_t year, const DatePredicate& p, const CalendarFormat fmt)
+{
+  const auto all = c.get_alldates_where(year, p, fmt);
+  const Date first = c.get_date_where(year, p, fmt);
+  CHECK(all.empty() ? first.empty() : first == all.front());
+  CHECK(c.get_date_where(std::to_string(year), p, fmt) == first);
+}
+
+}
+
+int main()
+{
+  OrthodoxCalendar c;
+  const auto sunday = DatePredicate::weekday(0);
+  const std::vector<DatePredicate> predicates = {
+    sunday,
+    DatePredicate::property(dvana10_nep_prazd),
+    DatePredicate::property(m1d1),
+    DatePredicate::property(sub_peredbogoyav),
+    sunday & DatePredicate::property(post_vel) & !DatePredicate::property(vel_prazd),
+    DatePredicate::property(pasha) & DatePredicate::property(m12d25)
+  };
+  for(const auto& p: predicates) {
+    //период внутри года, через границу года, от начала допустимого диапазона
+    check_period(c, Date(1999, 6, 1), Date(1999, 6, 30), p);
+    check_period(c, Date(1999, 6, 1), Date(1999, 12, 31), p);
+    check_period(c, Date(1999, 12, 20), Date(2001, 1, 10), p);
+    check_period(c, Date(2, 1, 3), Date(5, 1, 1), p);
+    check_period(c, Date("999999999999999", 12, 1), Date("1000000000000001", 1, 31), p);
+    for(auto fmt: {Julian, Grigorian, Milankovic}) {
+      check_year(c, 2000, p, fmt);
+      check_year(c, 2100, p, fmt);
+    }
+  }
+  //первое воскресенье июня 1999 г. (ст. ст.)
+  CHECK(c.get_date_inperiod_where(Date(1999, 6, 1), Date(1999, 6, 30), sunday) == Date(1999, 6, 7));
+  //первое воскресенье 2000 г. по григорианскому календарю
+  CHECK(c.get_date_where(2000, sunday, Grigorian) == Date(2000, 1, 2, Grigorian));
+  return check_result();
+}
@@ -0,0 +1,62 @@
+//глас, номер по пятидесятнице и рядовые чтения отдельного дня (расчет без построения OrthYear)
+//в сравнении с пакетным методом dates_info (расчет через OrthYear) для всех годов пасхального цикла
+//и нескольких наборов настроек отступок / преступок
+#include "oxc.h"
+#include "check.h"
+#include <cstdint>
+#include <vector>
+
+using namespace oxc;
+
+namespace {
+
+constexpr unsigned fields = OrthodoxCalendar::info_glas | OrthodoxCalendar::info_n50 | OrthodoxCalendar::info_apostol
+                          | OrthodoxCalendar::info_evangelie | OrthodoxCalendar::info_resurrect_evangelie;
+
+//все дни от first (включительно) до end (не включительно)
+std::vector<CompactDate> days_between(const Date& first, const Date& end)
+{
+  std::vector<CompactDate> result;
+  for(Date d = first; d < end; d = d.inc_by_days()) result.push_back(CompactDate(d));
+  return result;
+}
+
+//количество дней, для которых результаты двух путей расчета различаются
+std::size_t compare(const OrthodoxCalendar& c, const std::vector<CompactDate>& days)
+{
+  const auto info = c.dates_info(days, fields);
+  std::size_t mismatches{};
+  for(std::size_t i=0; i<days.size(); ++i) {
+    const Date d(days[i]);
+    if(c.date_glas(d) != info.glas[i] || c.date_n50(d) != info.n50[i] || c.date_apostol(d) != info.apostol[i]
+       || c.date_evangelie(d) != info.evangelie[i] || c.resurrect_evangelie(d) != info.resurrect_evangelie[i]) {
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+}
+
+int main()
+{
+  //годы 532..1063 - все позиции в пасхальном цикле
+  const auto cycle = days_between(Date(532, 1, 1), Date(1064, 1, 1));
+  //годы за пределом вычислений в int64_t
+  const auto big = days_between(Date("10000000000000000", 1, 1), Date("10000000000000002", 1, 1));
+  for(int options = 0; options < 4; ++options) {
+    OrthodoxCalendar c;
+    if(options == 1 || options == 2) c.set_spring_indent_apostol(true);
+    if(options >= 2) {
+      CHECK(c.set_winter_indent_weeks_1(12));
+      CHECK(c.set_winter_indent_weeks_2(8, 9));
+      CHECK(c.set_winter_indent_weeks_3(5, 6, 7));
+      CHECK(c.set_winter_indent_weeks_4(29, 28, 27, 26));
+      CHECK(c.set_winter_indent_weeks_5(33, 32, 31, 30, 17));
+      CHECK(c.set_spring_indent_weeks(20, 21));
+    }
+    CHECK(compare(c, cycle) == 0);
+    CHECK(compare(c, big) == 0);
+  }
+  return check_result();
+}
@@ -0,0 +1,66 @@
+//поиск дат a, рядом с которыми есть дата b (dates_inperiod_near и аналоги), в сравнении с перебором по дням.
+//окна смещений выходят за границу года, в т.ч. у 10^15 - предела вычислений в int64_t
+#include "oxc.h"
+#include "check.h"
+#include <vector>
+
+using namespace oxc;
+
+namespace {
+
+bool is_date_where(const OrthodoxCalendar& c, const Date& d, const DatePredicate& p)
+{
+  return c.exists_inperiod(d, d, p);
+}
+
+//даты a периода d1..d2, для которых найдется дата b со смещением min_offset..max_offset
+std::vector<CompactDate> brute_near(const OrthodoxCalendar& c, const Date& d1, const Date& d2,
+      const DatePredicate& a, const DatePredicate& b, const int min_offset, const int max_offset)
+{
+  std::vector<CompactDate> result;
+  for(Date d = d1; d <= d2; d = d.inc_by_days()) {
+    if(!is_date_where(c, d, a)) continue;
+    const Date first = min_offset < 0 ? d.dec_by_days(-min_offset) : d.inc_by_days(min_offset);
+    const Date last = max_offset < 0 ? d.dec_by_days(-max_offset) : d.inc_by_days(max_offset);
+    if(c.exists_inperiod(first, last, b)) result.push_back(CompactDate(d));
+  }
+  return result;
+}
+
+void check_near(const OrthodoxCalendar& c, const Date& d1, const Date& d2,
+      const DatePredicate& a, const DatePredicate& b, const int min_offset, const int max_offset)
+{
+  const auto expected = brute_near(c, d1, d2, a, b, min_offset, max_offset);
+  std::vector<CompactDate> view;
+  for(auto d: c.dates_inperiod_near(d1, d2, a, b, min_offset, max_offset)) view.push_back(d);
+  CHECK(view == expected);
+  CHECK(c.get_alldates_inperiod_near(d1, d2, a, b, min_offset, max_offset) == expected);
+  CHECK(c.count_inperiod_near(d1, d2, a, b, min_offset, max_offset) == expected.size());
+}
+
+}
+
+int main()
+{
+  OrthodoxCalendar c;
+  const auto christmas = DatePredicate::property(m12d25);
+  const auto theophany = DatePredicate::property(m1d6);
+  const auto sunday = DatePredicate::weekday(0);
+  const Date d1(1999, 11, 1), d2(2003, 2, 1);
+  //парная дата в следующем году
+  check_near(c, d1, d2, christmas, theophany, 1, 14);
+  check_near(c, d1, d2, christmas, theophany, 1, 11);
+  //парная дата в предыдущем году
+  check_near(c, d1, d2, theophany, christmas, -14, -1);
+  //суббота перед Богоявлением бывает и в декабре, и в январе
+  check_near(c, d1, d2, sunday, DatePredicate::property(sub_peredbogoyav), -7, 7);
+  check_near(c, d1, d2, sunday, DatePredicate::property(ned_peredbogoyav), 0, 0);
+  //окно шириной в год в обе стороны
+  check_near(c, d1, d2, DatePredicate::property(m1d1), DatePredicate::property(pasha), -366, 366);
+  //граница 10^15 между int64_t и big_int
+  const Date b1("999999999999999", 11, 1), b2("1000000000000001", 2, 1);
+  check_near(c, b1, b2, christmas, theophany, 1, 14);
+  check_near(c, b1, b2, theophany, christmas, -14, -1);
+  check_near(c, b1, b2, sunday, DatePredicate::property(sub_peredbogoyav), -7, 7);
+  return check_result();
+}
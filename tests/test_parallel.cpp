@@ -0,0 +1,39 @@
+//параллельные версии поиска за период (с исполнителем) в сравнении с последовательными,
+//в т.ч. для периодов, начинающихся с первых допустимых годов
+#include "oxc.h"
+#include "check.h"
+#include <vector>
+
+using namespace oxc;
+
+namespace {
+
+void check_period(const OrthodoxCalendar& c, const OrthodoxCalendar::Executor& ex, const Date& d1, const Date& d2)
+{
+  for(oxc_const p: {pasha, m12d25, sub_peredbogoyav, vel_prazd}) {
+    CHECK(c.get_date_inperiod_with(d1, d2, p, ex) == c.get_date_inperiod_with(d1, d2, p));
+    CHECK(c.get_alldates_inperiod_with(d1, d2, p, ex) == c.get_alldates_inperiod_with(d1, d2, p));
+    CHECK(c.get_compact_alldates_inperiod_with(d1, d2, p, ex) == c.get_compact_alldates_inperiod_with(d1, d2, p));
+  }
+  const std::vector<uint16_t> any = {m12d25, pasha, pasha};
+  CHECK(c.get_date_inperiod_withanyof(d1, d2, any, ex) == c.get_date_inperiod_withanyof(d1, d2, any));
+  CHECK(c.get_alldates_inperiod_withanyof(d1, d2, any, ex) == c.get_alldates_inperiod_withanyof(d1, d2, any));
+  const std::vector<uint16_t> all = {pasha, m3d25};
+  CHECK(c.get_date_inperiod_withallof(d1, d2, all, ex) == c.get_date_inperiod_withallof(d1, d2, all));
+}
+
+}
+
+int main()
+{
+  OrthodoxCalendar c;
+  const auto ex = OrthodoxCalendar::thread_executor(4);
+  check_period(c, ex, Date(2, 1, 3), Date(50, 1, 1));
+  check_period(c, ex, Date(1000, 3, 15, Grigorian), Date(4000, 11, 3, Grigorian));
+  check_period(c, ex, Date("999999999999000", 6, 1), Date("1000000000000000", 6, 1));
+  CHECK(c.get_alldates_inperiod_with(Date(2, 1, 3), Date(50, 1, 1), vel_prazd, ex).size() == 240);
+  //период длиннее цикла: поиск первой даты просматривает не более одного цикла
+  const std::vector<uint16_t> none = {pasha, m12d25};
+  CHECK(c.get_date_inperiod_withallof(Date(3, 1, 1), Date(1000000000000ULL, 1, 1), none, ex).empty());
+  return check_result();
+}
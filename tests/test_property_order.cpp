@@ -0,0 +1,38 @@
+//порядок дат в результатах методов поиска по признакам:
+//первый из перечисленных признаков, порядок расчета дат внутри признака, повторы
+#include "oxc.h"
+#include "check.h"
+#include <vector>
+
+using namespace oxc;
+
+int main()
+{
+  OrthodoxCalendar c;
+  //суббота перед Богоявлением в 2000 г. приходится на 31 дек. и 2 янв.; первой рассчитывается декабрьская
+  const std::vector<Date> sub = c.get_alldates_with(2000, sub_peredbogoyav);
+  CHECK(sub.size() == 2);
+  CHECK(sub.size() == 2 && sub[0] == Date(2000, 12, 31) && sub[1] == Date(2000, 1, 2));
+  CHECK(c.get_date_with(2000, sub_peredbogoyav) == Date(2000, 12, 31));
+  //withanyof: дата первого из перечисленных признаков, а не самая ранняя
+  const std::vector<uint16_t> any = {m12d25, pasha};
+  CHECK(c.get_date_withanyof(2000, any) == Date(2000, 12, 25));
+  const auto all = c.get_alldates_withanyof(2000, any);
+  CHECK(all.size() == 2 && all[0] == Date(2000, 12, 25) && all[1] == c.get_date_with(2000, pasha));
+  //повторяющийся признак дает повторяющуюся дату
+  const std::vector<uint16_t> twice = {pasha, pasha};
+  CHECK(c.get_alldates_withanyof(2000, twice).size() == 2);
+  //за период даты упорядочены, повторы сохраняются
+  const auto period = c.get_alldates_inperiod_withanyof(Date(2000, 1, 1), Date(2000, 12, 31), twice);
+  CHECK(period.size() == 2 && period[0] == period[1]);
+  const auto sorted = c.get_alldates_inperiod_withanyof(Date(2000, 1, 1), Date(2000, 12, 31), any);
+  CHECK(sorted.size() == 2 && sorted[0] < sorted[1]);
+  //ленивая последовательность выдает каждую дату один раз
+  std::vector<CompactDate> view;
+  for(auto d: c.dates_inperiod_withanyof(Date(2000, 1, 1), Date(2000, 12, 31), twice)) view.push_back(d);
+  CHECK(view.size() == 1 && Date(view[0]) == period[0]);
+  //withallof: первая дата первого признака, у которой есть все признаки
+  const std::vector<uint16_t> both = {sub_peredbogoyav, full7_svyatki};
+  CHECK(c.get_date_withallof(2000, both) == Date(2000, 12, 31));
+  return check_result();
+}